@@ -0,0 +1,173 @@
+/* gencorpus.c++
+ *
+ * William Miller
+ * Oct 17, 2026
+ *
+ * Deterministic generator of synthetic C++ source trees for the
+ * benchmarks. The same options always give byte identical trees, on
+ * any platform, as the generator uses its own splitmix64 sequence
+ * rather than the implementation defined standard distributions.
+ * Files mix comments, preprocessor lines, string and character
+ * literals, numbers and operator heavy statements with class, struct,
+ * namespace and typedef declarations, {density} per hundred lines.
+ *
+ *     gencorpus <dir> [--files N] [--lines N] [--density N]
+ *                     [--depth N] [--seed N]
+ *
+ */
+
+#include "../nanorc.h"
+
+class Random {
+public:
+	Random(uint64_t seed) : state(seed) {}
+
+	uint64_t next() {
+		uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+		return z ^ (z >> 31);
+	}
+	uint64_t below(uint64_t n) { return n ? next() % n : 0; }
+	bool chance(int percent) { return below(100) < static_cast<uint64_t>(percent); }
+
+private:
+	uint64_t state;
+};
+
+static const char* syllables[] = {"ka", "lo", "mi", "ne", "por", "qua", "ri", "sen", "tor", "vu",
+								  "wex", "yal", "zin", "bra", "cle", "dro", "fen", "gal", "hux", "jet"};
+static const char* types[] = {"int", "double", "char", "bool", "float", "long", "unsigned", "size_t"};
+
+static std::string identifier(Random &rng, bool upper) {
+	std::string name;
+	int n = 2 + rng.below(3);
+	for (int ii = 0; ii < n; ii ++) {
+		name += syllables[rng.below(sizeof(syllables) / sizeof(*syllables))];
+	}
+	if (upper) name[0] = std::toupper(name[0]);
+	return name;
+}
+
+static std::string statement(Random &rng, const std::vector<std::string> &names) {
+//--------------------------------------------------------------------
+// The names are drawn before the statement is built, as the order
+// in which the operands of a chain of '+' are evaluated is unspecified.
+//--------------------------------------------------------------------
+	std::string a = identifier(rng, false);
+	std::string b = identifier(rng, false);
+	std::string c = identifier(rng, false);
+	std::string t = names.empty() || rng.chance(60) ? types[rng.below(sizeof(types) / sizeof(*types))]
+													 : names[rng.below(names.size())];
+	switch (rng.below(8)) {
+		case 0: return t+" "+a+" = "+std::to_string(rng.below(100000))+";";
+		case 1: return a+" += "+b+" * ("+std::to_string(rng.below(64))+" - "+b+") / 2.5;";
+		case 2: return "if ("+a+" != "+b+" && "+a+" >= 0) { "+b+"++; }";
+		case 3: return "std::cout << \""+identifier(rng, true)+" \\\"quoted\\\" value\" << "+a+" << '\\n';";
+		case 4: return "for (int ii = 0; ii < "+a+".size(); ii ++) "+b+"[ii] = "+a+"[ii] << 1;";
+		case 5: return "return "+a+" ? "+b+"->"+c+"() : '"+static_cast<char>('a' + rng.below(26))+"';";
+		case 6: return "// "+a+" "+b+" "+c;
+		default: return t+"* "+a+" = static_cast<"+t+"*>("+b+"); /* "+c+" */";
+	}
+}
+
+static std::string declaration(Random &rng, std::vector<std::string> &names, int &depth) {
+	std::string name = identifier(rng, true);
+	switch (rng.below(4)) {
+		case 0:
+			names.push_back(name);
+			depth++;
+			return "class "+name+(names.size() > 1 && rng.chance(30) ? " : public "+names[rng.below(names.size() - 1)] : "")+" {";
+		case 1:
+			names.push_back(name);
+			depth++;
+			return "struct "+name+" {";
+		case 2:
+			depth++;
+			return "namespace "+identifier(rng, false)+" {";
+		default:
+			names.push_back(name+"_t");
+			return "typedef "+std::string(types[rng.below(sizeof(types) / sizeof(*types))])+" "+name+"_t;";
+	}
+}
+
+static std::string source(Random &rng, int lines, int density) {
+//--------------------------------------------------------------------
+// One file of roughly {lines} lines with {density} declarations per
+// hundred lines, every scope closed at the end.
+//--------------------------------------------------------------------
+	std::vector<std::string> names;
+	std::ostringstream out;
+	int depth = 0;
+	out << "/* Generated by gencorpus\n * " << identifier(rng, true) << "\n */\n\n";
+	out << "#include <" << identifier(rng, false) << ".h>\n#define " << identifier(rng, true) << " " << rng.below(1000) << "\n\n";
+	for (int ii = 6; ii < lines; ii ++) {
+		std::string indent(depth, '\t');
+		if (rng.below(100) < static_cast<uint64_t>(density)) {
+			out << indent << declaration(rng, names, depth) << "\n";
+		}
+		else if (depth > 0 && rng.chance(3)) {
+			depth--;
+			out << std::string(depth, '\t') << "};\n";
+		}
+		else if (rng.chance(4)) {
+			out << "\n";
+		}
+		else {
+			out << indent << statement(rng, names) << "\n";
+		}
+	}
+	while (depth-- > 0) {
+		out << std::string(depth, '\t') << "};\n";
+	}
+	return out.str();
+}
+
+int main(int argn, char** argv) {
+	std::string dir;
+	int nfiles;
+	int lines;
+	int density;
+	int depth;
+	uint64_t seed;
+	po::options_description description("Allowed Options");
+	po::positional_options_description positional;
+	description.add_options()
+		("dir", po::value<std::string>(&dir), "Directory to write the tree to.")
+		("files", po::value<int>(&nfiles)->default_value(100), "Number of files.")
+		("lines", po::value<int>(&lines)->default_value(1000), "Lines per file.")
+		("density", po::value<int>(&density)->default_value(2), "Declarations per hundred lines.")
+		("depth", po::value<int>(&depth)->default_value(2), "Directory nesting depth.")
+		("seed", po::value<uint64_t>(&seed)->default_value(1), "Random seed.")
+	;
+	positional.add("dir", 1);
+	po::variables_map vm;
+	po::store(po::command_line_parser(argn, argv).options(description).positional(positional).run(), vm);
+	po::notify(vm);
+	if (dir.empty()) {
+		std::cout << "Usage: gencorpus <dir> [options]\n" << description << std::endl;
+		return 1;
+	}
+
+	Random rng(seed);
+	uint64_t bytes = 0;
+	for (int ii = 0; ii < nfiles; ii ++) {
+		std::string path = dir;
+		for (int dd = 0, n = ii; dd < depth; dd ++, n /= 4) {
+			path += "/d"+std::to_string(n % 4);
+		}
+		std::error_code ec;
+		std::filesystem::create_directories(path, ec);
+		path += "/file"+std::to_string(ii)+(ii % 3 == 0 ? ".h" : ".cpp");
+		std::string text = source(rng, lines, density);
+		std::ofstream f(path, std::ios::binary);
+		f << text;
+		if (!f) {
+			std::cout << "Unable to write " << path << std::endl;
+			return 1;
+		}
+		bytes += text.size();
+	}
+	std::cout << "Generated " << nfiles << " files, " << bytes << " bytes in " << dir << std::endl;
+	return 0;
+}
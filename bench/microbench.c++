@@ -0,0 +1,215 @@
+/* microbench.c++
+ *
+ * William Miller
+ * Oct 17, 2026
+ *
+ * Micro-benchmarks of the pipeline stages on a tree of code files,
+ * e.g. one made by gencorpus. Each benchmark runs {iterations} times
+ * and the fastest run is reported, as a table or as JSON.
+ *
+ *     microbench [--json] [--iterations N] <file or directory> ...
+ *
+ * rcstreambuf   reading every file a character at a time through
+ *               RCStreamBuf
+ * cpp_lex       Lexer::lex of every file, lexing and extraction
+ * find_new      Lexer::find_new_keywords merging each file's keywords
+ * sort          KeywordSet::sort of every identifier in the tree
+ * rc_parse      loading an rc file holding those identifiers and
+ *               rcParse of it
+ * rc_write      write of those identifiers to an rc file
+ *
+ */
+
+#include "../nanorc.h"
+
+bool verbose = false;
+bool lexverbose = false;
+bool ctxverbose = false;
+KeywordSet keywords;
+KeywordSet ignored;
+std::string keywordColor = "brightcyan";
+int ruleLength = 1024;
+
+struct Result {
+	std::string name;
+	double seconds;
+	uint64_t bytes;
+	uint64_t items;
+	std::string unit;
+};
+
+template <typename Setup, typename Body>
+static Result measure(std::string name, std::string unit, int iterations, Setup setup, Body body) {
+//--------------------------------------------------------------------
+// Runs {setup} and then times {body} {iterations} times. {body}
+// returns the bytes and items it handled.
+//--------------------------------------------------------------------
+	Result r = {name, 0, 0, 0, unit};
+	for (int ii = 0; ii < iterations; ii ++) {
+		setup();
+		auto t0 = RunStats::clock::now();
+		std::pair<uint64_t, uint64_t> handled = body();
+		double dt = RunStats::since(t0);
+		if (ii == 0 || dt < r.seconds) r.seconds = dt;
+		r.bytes = handled.first;
+		r.items = handled.second;
+	}
+	return r;
+}
+
+int main(int argn, char** argv) {
+	std::vector<std::string> paths;
+	int iterations;
+	po::options_description description("Allowed Options");
+	po::positional_options_description positional;
+	description.add_options()
+		("paths", po::value<std::vector<std::string> >(&paths)->multitoken(), "Files and directories"
+			" to benchmark on.")
+		("iterations,n", po::value<int>(&iterations)->default_value(5), "Runs of each benchmark.")
+		("json", po::bool_switch()->default_value(false), "Print the results as JSON.")
+	;
+	positional.add("paths", -1);
+	po::variables_map vm;
+	po::store(po::command_line_parser(argn, argv).options(description).positional(positional).run(), vm);
+	po::notify(vm);
+	bool json = vm["json"].as<bool>();
+	if (paths.empty()) {
+		std::cout << "Usage: microbench [options] <file or directory> ...\n" << description << std::endl;
+		return 1;
+	}
+
+	Walker walker({"h", "h++", "hpp", "c", "c++", "cpp"});
+	std::vector<std::string> files = walker.list(paths);
+	// Files which vanished or cannot be read since the walk are skipped
+	uint64_t total = 0;
+	for (auto f = files.begin(); f != files.end(); ) {
+		std::error_code ec;
+		uint64_t size = std::filesystem::file_size(*f, ec);
+		if (ec) {
+			f = files.erase(f);
+			continue;
+		}
+		total += size;
+		f++;
+	}
+	std::vector<std::string> specifiers = {"typedef", "class", "namespace"};
+	std::vector<Result> results;
+
+	results.push_back(measure("rcstreambuf", "lines", iterations, []{}, [&] {
+		uint64_t lines = 0;
+		for (auto &f : files) {
+			std::ifstream file(f);
+			RCStreamBuf buf(file.rdbuf());
+			std::istream in(&buf);
+			char c;
+			while (in.get(c)) {}
+			lines += buf.line();
+		}
+		return std::make_pair(total, lines);
+	}));
+
+	results.push_back(measure("cpp_lex", "lexemes", iterations, []{}, [&] {
+		Lexer lexer(specifiers);
+		uint64_t before = runStats[Lex].lexemes;
+		for (auto &f : files) {
+			lexer.lex(f, "c++");
+		}
+		return std::make_pair(total, runStats[Lex].lexemes - before);
+	}));
+
+	std::vector<Lexer> lexers;
+	KeywordSet found;
+	results.push_back(measure("find_new", "keywords", iterations, [&] {
+		lexers.clear();
+		for (auto &f : files) {
+			lexers.emplace_back(specifiers);
+			lexers.back().lex(f, "c++");
+		}
+		found.clear();
+	}, [&] {
+		for (auto &lexer : lexers) {
+			lexer.find_new_keywords(found);
+		}
+		return std::make_pair(uint64_t(0), uint64_t(found.size()));
+	}));
+	lexers.clear();
+
+	// Every identifier in the tree, in hash order, stands in for a
+	// large keyword set for the remaining benchmarks
+	std::unordered_set<std::string> identifiers;
+	for (auto &f : files) {
+		MappedFile src(f);
+		const char* p = src.data();
+		size_t n = src.size();
+		for (size_t pos = 0; pos < n; ) {
+			if (is_class(p[pos], CC_IdentStart)) {
+				size_t end = skip_ident(p, pos + 1, n);
+				identifiers.insert(std::string(p + pos, end - pos));
+				pos = end;
+			}
+			else {
+				pos++;
+			}
+		}
+	}
+	KeywordSet unsorted;
+	for (auto &i : identifiers) {
+		unsorted.insert(i);
+	}
+
+	KeywordSet sorted;
+	results.push_back(measure("sort", "keywords", iterations, [&] { sorted = unsorted; }, [&] {
+		sorted.sort();
+		return std::make_pair(uint64_t(0), uint64_t(sorted.size()));
+	}));
+
+	std::string base = (std::filesystem::temp_directory_path() / "microbench-base.rc").string();
+	std::string rcfile = (std::filesystem::temp_directory_path() / "microbench.rc").string();
+	std::ofstream(base) << "syntax \"c\" \"\\.(c|h)$\"\n\n## custom keywords\n\n";
+	keywords = sorted;
+	RcDocument rc;
+	results.push_back(measure("rc_write", "keywords", iterations, [&] {
+		std::filesystem::copy_file(base, rcfile, std::filesystem::copy_options::overwrite_existing);
+		rc.load(rcfile);
+	}, [&] {
+		write(rc, "user");
+		return std::make_pair(uint64_t(rc.size()), uint64_t(keywords.size()));
+	}));
+
+	KeywordSet parsed;
+	results.push_back(measure("rc_parse", "keywords", iterations, []{}, [&] {
+		RcDocument doc(rcfile);
+		parsed = rcParse(doc, "user");
+		return std::make_pair(uint64_t(doc.size()), uint64_t(parsed.size()));
+	}));
+	std::remove(base.c_str());
+	std::remove(rcfile.c_str());
+	if (parsed.size() != keywords.size()) {
+		std::cout << "rcParse read back " << parsed.size() << " of " << keywords.size() << " keywords" << std::endl;
+		return 1;
+	}
+
+	if (json) {
+		std::cout << "{\"files\": " << files.size() << ", \"bytes\": " << total << ", \"iterations\": "
+			<< iterations << ",\n \"benchmarks\": [";
+		for (size_t ii = 0; ii < results.size(); ii ++) {
+			Result &r = results[ii];
+			std::cout << (ii ? ",\n  " : "\n  ") << std::fixed << std::setprecision(6) << "{\"name\": \""
+				<< r.name << "\", \"seconds\": " << r.seconds << ", \"bytes\": " << r.bytes
+				<< ", \"items\": " << r.items << ", \"unit\": \"" << r.unit << "\"}";
+		}
+		std::cout << "]}" << std::endl;
+		return 0;
+	}
+	std::cout << files.size() << " files, " << total << " bytes, best of " << iterations << "\n";
+	for (auto &r : results) {
+		std::cout << std::left << std::setw(12) << r.name << std::right << std::fixed << std::setprecision(4)
+			<< std::setw(10) << r.seconds << " s" << std::setprecision(1);
+		if (r.bytes) std::cout << std::setw(10) << r.bytes / 1e6 / r.seconds << " MB/s";
+		else std::cout << std::setw(15) << "";
+		std::cout << std::setw(12) << std::setprecision(0) << r.items / r.seconds << " " << r.unit << "/s"
+			<< std::setw(10) << r.items << " " << r.unit << "\n";
+	}
+	std::cout << std::flush;
+	return 0;
+}
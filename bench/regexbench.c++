@@ -0,0 +1,137 @@
+/* regexbench.c++
+ *
+ * William Miller
+ * Oct 17, 2026
+ *
+ * Compares the highlighting rules written by the original emitter,
+ * four anchoring variants of every ten keywords, with the trie
+ * factored rules of RegexTrie. The keywords are identifiers taken
+ * from the input file, and each rule set is compiled and matched
+ * against every line of that file the way nano highlights a buffer.
+ *
+ *     regexbench <file> [keywords] [rule length]
+ *
+ */
+
+#include "../nanorc.h"
+
+#include <regex.h>
+
+static std::vector<std::string> legacy(const std::vector<std::string> &words, std::string color) {
+	std::vector<std::string> rgx = {"[^A-Za-z0-9\\_]", "^", "[^A-Za-z0-9\\_]", "^"};
+	std::vector<std::string> sfx = {"[^A-Za-z0-9\\_]", "[^A-Za-z0-9\\_]", "$", "$"};
+	std::vector<std::string> lines;
+	for (size_t kk = 0; kk < rgx.size(); kk ++) {
+		std::string prefix("\tcolor "+color+" \""+rgx[kk]+"(");
+		std::string suffix(")"+sfx[kk]+"\"");
+		std::string out = prefix;
+		for (size_t ii = 0; ii < words.size(); ii ++) {
+			if (ii % 10 != 0) out += "|";
+			out += words[ii];
+			if (ii % 10 == 9) {
+				lines.push_back(out+suffix);
+				out = prefix;
+			}
+		}
+		if (out != prefix) lines.push_back(out+suffix);
+	}
+	return lines;
+}
+
+static std::string pattern(const std::string &rule) {
+	size_t start = rule.find('"');
+	return rule.substr(start + 1, rule.find_last_of('"') - start - 1);
+}
+
+static void run(std::string name, const std::vector<std::string> &rules, const std::vector<std::string> &lines) {
+//--------------------------------------------------------------------
+// Compiles {rules} and matches each against every line, continuing
+// after each match with REG_NOTBOL as nano does.
+//--------------------------------------------------------------------
+	size_t bytes = 0;
+	for (auto &r : rules) {
+		bytes += r.size() + 1;
+	}
+	auto t0 = std::chrono::steady_clock::now();
+	std::vector<regex_t> compiled(rules.size());
+	for (size_t ii = 0; ii < rules.size(); ii ++) {
+		if (regcomp(&compiled[ii], pattern(rules[ii]).c_str(), REG_EXTENDED) != 0) {
+			std::cout << "Unable to compile " << rules[ii] << std::endl;
+			exit(1);
+		}
+	}
+	auto t1 = std::chrono::steady_clock::now();
+	size_t matches = 0;
+	for (auto &re : compiled) {
+		for (auto &line : lines) {
+			regmatch_t m;
+			size_t pos = 0;
+			while (pos < line.size() && regexec(&re, line.c_str() + pos, 1, &m, pos ? REG_NOTBOL : 0) == 0) {
+				matches++;
+				pos += m.rm_eo > 0 ? m.rm_eo : 1;
+			}
+		}
+	}
+	auto t2 = std::chrono::steady_clock::now();
+	for (auto &re : compiled) {
+		regfree(&re);
+	}
+	std::cout << std::left << std::setw(8) << name << std::right
+		<< std::setw(6) << rules.size() << " rules " << std::setw(8) << bytes << " bytes"
+		<< std::fixed << std::setprecision(2)
+		<< std::setw(10) << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms compile"
+		<< std::setw(10) << std::chrono::duration<double, std::milli>(t2 - t1).count() << " ms match"
+		<< std::setw(8) << matches << " matches" << std::endl;
+}
+
+int main(int argn, char** argv) {
+	if (argn < 2) {
+		std::cout << "Usage: regexbench <file> [keywords] [rule length]" << std::endl;
+		return 1;
+	}
+	size_t nkeywords = argn > 2 ? std::stoul(argv[2]) : 2000;
+	size_t length = argn > 3 ? std::stoul(argv[3]) : 1024;
+
+	std::ifstream f(argv[1]);
+	std::vector<std::string> lines;
+	std::set<std::string> identifiers;
+	std::string line;
+	while (std::getline(f, line)) {
+		lines.push_back(line);
+		for (size_t ii = 0; ii < line.size(); ) {
+			if (std::isalpha(static_cast<unsigned char>(line[ii])) || line[ii] == '_') {
+				size_t jj = ii;
+				while (jj < line.size() && (std::isalnum(static_cast<unsigned char>(line[jj])) || line[jj] == '_')) jj++;
+				if (jj - ii >= 3) identifiers.insert(line.substr(ii, jj - ii));
+				ii = jj;
+			}
+			else {
+				ii++;
+			}
+		}
+	}
+	std::vector<std::string> all(identifiers.begin(), identifiers.end());
+	std::vector<std::string> words;
+	for (size_t ii = 0; ii < nkeywords && ii < all.size(); ii ++) {
+		words.push_back(all[ii * all.size() / std::min(nkeywords, all.size())]);
+	}
+	std::cout << lines.size() << " lines, " << words.size() << " keywords" << std::endl;
+
+	auto old_rules = legacy(words, "brightcyan");
+	auto new_rules = RegexTrie::rules(words, "brightcyan", length);
+
+	std::vector<std::string> parsed;
+	for (auto &r : new_rules) {
+		auto w = RegexTrie::expand(r.substr(r.find('(') + 1, r.find_last_of(')') - r.find('(') - 1));
+		parsed.insert(parsed.end(), w.begin(), w.end());
+	}
+	std::sort(parsed.begin(), parsed.end());
+	if (parsed != words) {
+		std::cout << "Trie rules do not read back to the same keywords" << std::endl;
+		return 1;
+	}
+
+	run("legacy", old_rules, lines);
+	run("trie", new_rules, lines);
+	return 0;
+}
@@ -0,0 +1,118 @@
+/* charclass.c++
+ *
+ * William Miller
+ * Oct 17, 2026
+ *
+ */
+
+#include "charclass.h"
+
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CC_SIMD 32
+typedef __m256i vec;
+static inline vec load(const char* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+static inline vec splat(char c) { return _mm256_set1_epi8(c); }
+static inline vec eq(vec a, vec b) { return _mm256_cmpeq_epi8(a, b); }
+static inline vec gt(vec a, vec b) { return _mm256_cmpgt_epi8(a, b); }
+static inline vec vor(vec a, vec b) { return _mm256_or_si256(a, b); }
+static inline vec vand(vec a, vec b) { return _mm256_and_si256(a, b); }
+static inline unsigned bits(vec v) { return static_cast<unsigned>(_mm256_movemask_epi8(v)); }
+static const unsigned all_bits = 0xffffffffu;
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define CC_SIMD 16
+typedef __m128i vec;
+static inline vec load(const char* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+static inline vec splat(char c) { return _mm_set1_epi8(c); }
+static inline vec eq(vec a, vec b) { return _mm_cmpeq_epi8(a, b); }
+static inline vec gt(vec a, vec b) { return _mm_cmpgt_epi8(a, b); }
+static inline vec vor(vec a, vec b) { return _mm_or_si128(a, b); }
+static inline vec vand(vec a, vec b) { return _mm_and_si128(a, b); }
+static inline unsigned bits(vec v) { return static_cast<unsigned>(_mm_movemask_epi8(v)); }
+static const unsigned all_bits = 0xffffu;
+#endif
+
+#ifdef CC_SIMD
+static inline vec in_range(vec v, char lo, char hi) {
+	// Signed compares, so bytes >= 0x80 are never in an ASCII range
+	return vand(gt(v, splat(lo - 1)), gt(splat(hi + 1), v));
+}
+#endif
+
+size_t skip_ident(const char* p, size_t pos, size_t n) {
+#ifdef CC_SIMD
+	while (pos + CC_SIMD <= n) {
+		vec v = load(p + pos);
+		vec ident = vor(vor(in_range(vor(v, splat(0x20)), 'a', 'z'), in_range(v, '0', '9')), 
+						vor(eq(v, splat('_')), eq(v, splat('~'))));
+		unsigned stop = ~bits(ident) & all_bits;
+		if (stop) return pos + __builtin_ctz(stop);
+		pos += CC_SIMD;
+	}
+#endif
+	while (pos < n && is_class(p[pos], CC_Ident)) {
+		pos++;
+	}
+	return pos;
+}
+
+size_t skip_space(const char* p, size_t pos, size_t n) {
+#ifdef CC_SIMD
+	while (pos + CC_SIMD <= n) {
+		vec v = load(p + pos);
+		unsigned stop = ~bits(vor(eq(v, splat(' ')), in_range(v, '\t', '\r'))) & all_bits;
+		if (stop) return pos + __builtin_ctz(stop);
+		pos += CC_SIMD;
+	}
+#endif
+	while (pos < n && is_class(p[pos], CC_Space)) {
+		pos++;
+	}
+	return pos;
+}
+
+size_t find_either(const char* p, size_t pos, size_t n, char a, char b) {
+#ifdef CC_SIMD
+	vec va = splat(a);
+	vec vb = splat(b);
+	while (pos + CC_SIMD <= n) {
+		vec v = load(p + pos);
+		unsigned found = bits(vor(eq(v, va), eq(v, vb)));
+		if (found) return pos + __builtin_ctz(found);
+		pos += CC_SIMD;
+	}
+#endif
+	while (pos < n && p[pos] != a && p[pos] != b) {
+		pos++;
+	}
+	return pos < n ? pos : n;
+}
+
+size_t find_comment_end(const char* p, size_t pos, size_t n) {
+//--------------------------------------------------------------------
+// Position of the '*' of the first "*/" at or after {pos}.
+//--------------------------------------------------------------------
+#ifdef CC_SIMD
+	vec star = splat('*');
+	vec slash = splat('/');
+	while (pos + CC_SIMD + 1 <= n) {
+		unsigned found = bits(vand(eq(load(p + pos), star), eq(load(p + pos + 1), slash)));
+		if (found) return pos + __builtin_ctz(found);
+		pos += CC_SIMD;
+	}
+#endif
+	while (pos + 1 < n) {
+		if (p[pos] == '*' && p[pos + 1] == '/') return pos;
+		pos++;
+	}
+	return n;
+}
+
+size_t find_newline(const char* p, size_t pos, size_t n) {
+	if (pos >= n) return n;
+	const void* nl = std::memchr(p + pos, '\n', n - pos);
+	return nl ? static_cast<const char*>(nl) - p : n;
+}
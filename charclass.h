@@ -0,0 +1,72 @@
+/* charclass.h
+ *
+ * William Miller
+ * Oct 17, 2026
+ *
+ * Character classification table and scanning kernels for the lexer
+ * hot loop. The kernels skip runs of identifier characters and 
+ * whitespace and search for the end of string bodies and comments 
+ * 16 (SSE2) or 32 (AVX2, when compiled with -mavx2 or -march=native)
+ * bytes at a time, with a scalar fallback on other targets. Each 
+ * returns the first position at or after {pos} which ends the run,
+ * or {n} if the run reaches the end of the buffer.
+ *
+ */
+
+#ifndef CHARCLASS_H
+#define CHARCLASS_H
+
+#include <array>
+#include <cstddef>
+
+enum char_class : unsigned char {
+	CC_Alpha      = 1 << 0,								// A-Z a-z
+	CC_Digit      = 1 << 1,								// 0-9
+	CC_IdentStart = 1 << 2,								// Alpha, '_' and '~'
+	CC_Ident      = 1 << 3,								// IdentStart and Digit
+	CC_Space      = 1 << 4,								// isspace() in the C locale
+	CC_Operator   = 1 << 5								// One character operators
+};
+
+constexpr std::array<unsigned char, 256> make_char_classes() {
+	std::array<unsigned char, 256> table{};
+	for (int c = 'a'; c <= 'z'; c ++) table[c] |= CC_Alpha | CC_IdentStart | CC_Ident;
+	for (int c = 'A'; c <= 'Z'; c ++) table[c] |= CC_Alpha | CC_IdentStart | CC_Ident;
+	for (int c = '0'; c <= '9'; c ++) table[c] |= CC_Digit | CC_Ident;
+	table['_'] |= CC_IdentStart | CC_Ident;
+	table['~'] |= CC_IdentStart | CC_Ident;
+	for (int c = '\t'; c <= '\r'; c ++) table[c] |= CC_Space;
+	table[' '] |= CC_Space;
+	for (const char* op = "()[]{},.!-+/*<>=&:?%|^"; *op; op ++) {
+		table[static_cast<unsigned char>(*op)] |= CC_Operator;
+	}
+	return table;
+}
+
+constexpr std::array<unsigned char, 256> char_classes = make_char_classes();
+
+inline bool is_class(char c, unsigned char cc) {
+	return char_classes[static_cast<unsigned char>(c)] & cc;
+}
+
+inline bool is_twoc_operator(char a, char b) {
+	switch (a) {
+		case '>':	return b == '>' || b == '=';
+		case '<':	return b == '<' || b == '=';
+		case '=':	return b == '=';
+		case '!':	return b == '=';
+		case ':':	return b == ':';
+		case '-':	return b == '>';
+		case '&':	return b == '&';
+		case '|':	return b == '|';
+		default :	return false;
+	}
+}
+
+size_t skip_ident(const char* p, size_t pos, size_t n);
+size_t skip_space(const char* p, size_t pos, size_t n);
+size_t find_either(const char* p, size_t pos, size_t n, char a, char b);
+size_t find_comment_end(const char* p, size_t pos, size_t n);
+size_t find_newline(const char* p, size_t pos, size_t n);
+
+#endif // CHARCLASS_H
@@ -0,0 +1,67 @@
+/* keywordset.c++
+ *
+ * William Miller
+ * Oct 17, 2026
+ *
+ */
+
+#include "keywordset.h"
+
+#include <algorithm>
+
+KeywordSet::KeywordSet(const std::vector<std::string> &words, kw_origin origin) {
+	entries.reserve(words.size());
+	index.reserve(words.size());
+	for (auto &w : words) {
+		insert(w, origin);
+	}
+}
+
+bool KeywordSet::insert(const std::string &word, kw_origin origin) {
+//--------------------------------------------------------------------
+// Adds {word} if it is not already present, returns whether it was
+// added. Keywords which did not come from the rc file are flagged
+// as changed. Empty keywords are never stored.
+//--------------------------------------------------------------------
+	if (word.empty() || word[0] == char(0)) return false;
+	auto inserted = index.emplace(word, entries.size());
+	if (!inserted.second) return false;
+	entries.push_back(Entry{word, origin, origin != RcFile});
+	return true;
+}
+
+bool KeywordSet::erase(const std::string &word) {
+//--------------------------------------------------------------------
+// Removes {word} in constant time by moving the last keyword into 
+// its place, so the set must be sorted again before sorted 
+// iteration is relied on.
+//--------------------------------------------------------------------
+	auto it = index.find(word);
+	if (it == index.end()) return false;
+	size_t pos = it->second;
+	index.erase(it);
+	if (pos != entries.size() - 1) {
+		entries[pos] = std::move(entries.back());
+		index[entries[pos].word] = pos;
+	}
+	entries.pop_back();
+	return true;
+}
+
+const KeywordSet::Entry* KeywordSet::find(const std::string &word) const {
+	auto it = index.find(word);
+	return it == index.end() ? nullptr : &entries[it->second];
+}
+
+void KeywordSet::sort() {
+	std::stable_sort(entries.begin(), entries.end(), 
+		[](const Entry &a, const Entry &b) { return a.word < b.word; });
+	for (size_t ii = 0; ii < entries.size(); ii ++) {
+		index[entries[ii].word] = ii;
+	}
+}
+
+void KeywordSet::clear() {
+	entries.clear();
+	index.clear();
+}
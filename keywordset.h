@@ -0,0 +1,57 @@
+/* keywordset.h
+ *
+ * William Miller
+ * Oct 17, 2026
+ *
+ * Set of keywords with hashed membership and per-keyword origin
+ * and change flags. Iteration is in insertion order until sort()
+ * is called, after which it is in lexicographic order until the 
+ * next erase().
+ *
+ */
+
+#ifndef KEYWORDSET_H
+#define KEYWORDSET_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+enum kw_origin {
+	RcFile,											// Read from the existing rc file
+	Manual,											// Given on the command line
+	Parsed											// Extracted from a code file
+};
+
+class KeywordSet {
+public:
+	struct Entry {
+		std::string word;
+		kw_origin origin;
+		bool changed;
+	};
+
+	KeywordSet() {}
+	KeywordSet(const std::vector<std::string> &words, kw_origin origin = RcFile);
+
+	bool insert(const std::string &word, kw_origin origin = RcFile);
+	bool erase(const std::string &word);
+	bool contains(const std::string &word) const { return index.count(word) != 0; }
+	const Entry* find(const std::string &word) const;
+
+	void sort();
+	void clear();
+
+	size_t size() const { return entries.size(); }
+	bool empty() const { return entries.empty(); }
+	const Entry& operator[](size_t ii) const { return entries[ii]; }
+
+	std::vector<Entry>::const_iterator begin() const { return entries.begin(); }
+	std::vector<Entry>::const_iterator end() const { return entries.end(); }
+
+private:
+	std::vector<Entry> entries;
+	std::unordered_map<std::string, size_t> index;
+};
+
+#endif // KEYWORDSET_H
@@ -12,7 +12,7 @@
 
 #include "lexcontext.h"
 
-LexContext::LexContext(std::string lex, lex_type type, std::string ctx, std::string file, int line) {
+LexContext::LexContext(std::string lex, lex_type type, std::string ctx, int file, int line) {
 	this->lex = lex;
 	this->type = type;
 	this->ctx = ctx;
@@ -24,38 +24,6 @@ void LexContext::depth(int d) {
 	ctx_depth = d;
 }
 
-void LexContext::make(int s, int e, std::vector<LexContext> lexemes) {
-	int lsize = lexemes.size() - 1;
-	while (s > 0) {
-		if (lexemes[s - 1].lex.find("\n") != std::string::npos) {
-			break;
-		}
-		s--;
-	}
-	while (e < lsize && lexemes[e++ + 1].lex.find("\n") == std::string::npos) {}
-	std::string context("    ");
-	std::string lex;
-	bool highlighted = false;	
-	int rs, re;
-	for (int ii = s; ii < e; ii ++) {
-		if (lexemes[ii].isspecifier && !highlighted) context += green;
-		if ((rs = lexemes[ii].lex.find("\n")) != std::string::npos) {
-			lex = lexemes[ii].lex;
-			re = lex.find_last_of("\n");
-			lex.replace(rs, re - rs + 1, "\n    ");
-			context += lex;
-		}
-		else {
-			context += lexemes[ii].lex;
-		}
-		if (lexemes[ii].isspecifier && !highlighted) {
-			context += white+bright;
-			highlighted = true;			
-		}
-	}
-	this->ctx = context+"\n";
-}
-
 void LexContext::print_context() {
 	if (ctxverbose) std::cout << " in the context\n" << bright+ctx+res << std::flush;	
 }
@@ -4,7 +4,8 @@
  * Mar 19, 2020
  *
  * Class for storing parameters relating to the context of a 
- * lexeme.
+ * lexeme, and the compact token record the lexer streams through
+ * keyword extraction.
  *
  */
 
@@ -12,6 +13,7 @@
 #define LEXCONTEXT_H
 
 #include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -20,7 +22,7 @@
 
 extern bool ctxverbose;
 
-enum lex_type {
+enum lex_type : unsigned char {
 	Operator,
 	Character,
 	String,
@@ -31,21 +33,29 @@ enum lex_type {
 	Unspecified
 };
 
+struct Token {
+	size_t offset;									// Start of the lexeme in the mapped file
+	size_t length;
+	uint32_t line;
+	uint32_t file;									// Interned file id, see Lexer::intern
+	lex_type type;
+	bool isspecifier;
+	bool newline;									// Lexeme contains a line break
+};
+
 class LexContext {
 public:
-	LexContext(std::string lex, lex_type type, std::string ctx = "", std::string file = "", int line = 0);
+	LexContext(std::string lex, lex_type type, std::string ctx = "", int file = 0, int line = 0);
 
 	std::string lex;
 	lex_type type;
 	std::string ctx;
-	std::string file;
+	int file;
 	int line;
 
-	bool isspecifier = false;
 	int ctx_depth = 0;
 
 	void depth(int d);
-	void make(int s, int e, std::vector<LexContext> lexemes);
 	void print_context();
 };
 
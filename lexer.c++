@@ -1,25 +1,42 @@
 #include "nanorc.h"
 
 Lexer::Lexer(std::vector<std::string> specifiers) {
-	this->specifiers = specifiers;
+	this->specifiers = KeywordSet(specifiers);
 }
 
-std::vector<std::string> Lexer::onec_operators = {"(", ")", "[", "]", "{", "}", ",", ".", "!",
-												  "-", "+", "/", "*", "<", ">", "=", "&", ":",
-												  "?", "%", "|", "^"};
-std::vector<std::string> Lexer::twoc_operators = {">>", "<<", "::", "==", "<=", ">=", "!=", 
-												  "->", "&&", "||"};
+std::deque<std::string> Lexer::filenames;
+std::unordered_map<std::string, int> Lexer::file_ids;
 
 void Lexer::lex(std::string file, std::string language) {
 //--------------------------------------------------------------------
 // Front end for language specific lexing functions. Supported 
 // languages are: C++.
+//
+// Keywords are extracted while the file is lexed, see append(), and
+// are collected until they are taken by extract() or 
+// find_new_keywords().
 //--------------------------------------------------------------------
 	this->file = file;
+	file_id = intern(file);
+	state = Scan;
+	window.clear();
+	pending.clear();
+	base = 0;
+	ntokens = 0;
+	newlines = 0;
+	line_start = 0;
+	terminated = "";
+	if (!src.open(file)) {
+		std::cout << "Unable to open "+red << file << res+white << std::endl;
+		return;
+	}
 	language = tolower(language);
+	auto t0 = RunStats::clock::now();
 	if (language == "c++") {
 		cpp_lex();
 	}
+	finish();
+	runStats.add(Lex, RunStats::since(t0), 1, src.size(), ntokens);
 }
 
 void Lexer::cpp_lex() {
@@ -30,196 +47,313 @@ void Lexer::cpp_lex() {
 // all strings and multitline comments. 
 //
 // WARNING: Does not support multiline comment nesting.
+//
+// Characters are classified through the char_classes table and runs 
+// of identifier characters, whitespace, string bodies and comments are
+// skipped with the vectorized kernels in charclass.h.
 //------------------------------------------------------------------------
-	std::ifstream f(file);
-	sb = RCStreamBuf(f.rdbuf());
-	std::string lexeme("");
+	const size_t length = src.size();
+	const char* buf = src.data();
+	std::string_view text = src.view(0, length);
+	size_t pos = 0;
+	size_t start;
 
-	int length = get_length(file);
-	int prev = -1;
-
-	while (sb.sgetc() != EOF) {
-		if (prev == sb.pos()) {
-			std::string problem(1, sb.sgetc());
-	 		switch (sb.sgetc()) {
-	            case '\a':  problem = "\\a";        break;
-	            case '\b':  problem = "\\b";        break;
-	            case '\f':  problem = "\\f";        break;
-	            case '\n':  problem = "\\n";        break;
-	            case '\r':  problem = "\\r";        break;
-	            case '\t':  problem = "\\t";        break;
-	            case '\v':  problem = "\\v";        break;
-	            default  :							break;
-	        }
-			std::cout << "Problem with character "+red << problem << res+" at index "+magenta << sb.pos() << res+" in the context "+red;
-			problem = "";
-			int s = sb.pos() - 10 > 0 ? sb.pos() - 10 : 0;
-			int e = sb.pos() + 10 < length - 1 ? sb.pos() + 10 : length - 1;
-			sb.seek(e - s);
-			std::cout << sb.gets(e-s) << res << std::endl;
-			exit(1);
-		}
-		prev = sb.pos();
-		if (sb.sgetc() == '\'') {
-			lexeme += sb.rget();
-			do {
-				if (sb.sgetc() == '\\') {
-					lexeme += sb.rget();
-					lexeme += sb.rget();
-				}
-				lexeme += sb.rget();
-			} while(lexeme.back() != '\'');
-			if (lexverbose) std::cout << lexeme.size() << " Character literal " << lexeme << std::endl;
-			this->append(lexeme, lex_type::Character);
-		}
-		else if (sb.sgetc() == '\"') {
-			lexeme = sb.gets(2);
-			while (lexeme.back() != '\"') {
-				if (lexeme.back() == '\\') {
-					lexeme += sb.rget();
-				}
-				lexeme += sb.rget();
+	while (pos < length) {
+		start = pos;
+		char c = buf[pos];
+		if (c == '\'' || c == '\"') {
+			pos++;
+			while ((pos = find_either(buf, pos, length, c, '\\')) < length && buf[pos] == '\\') {
+				pos += 2;
 			}
-			if (lexverbose) std::cout << lexeme.size() << " String literal " << lexeme << std::endl;
-			this->append(lexeme, lex_type::String);
-		}
-		else if (sb.sgetc() == '/' && sb.peek() == '*') {
-			lexeme = sb.gets(2);
-			while (lexeme.find("*/") == std::string::npos) {
-				lexeme += sb.rget();
+			pos = std::min(pos + 1, length);
+			if (c == '\'') {
+				if (lexverbose) std::cout << pos - start << " Character literal " << text.substr(start, pos - start) << std::endl;
+				this->append(start, pos, lex_type::Character);
 			}
-			if (lexverbose) std::cout << lexeme.size() << " Multiline comment " << lexeme << std::endl;
-			this->append(lexeme, lex_type::Comment);
-		}
-		else if (sb.pos() < length - 1 && sb.sgetc() == '/' && sb.peek() == '/') {
-			while (sb.sgetc() != EOF && sb.sgetc() != '\n') {
-				sb.sbumpc();
+			else {
+				if (lexverbose) std::cout << pos - start << " String literal " << text.substr(start, pos - start) << std::endl;
+				this->append(start, pos, lex_type::String);
 			}
 		}
-		else if (isalpha(sb.sgetc()) || sb.sgetc() == '_' || sb.sgetc() == '~') {
-			while (isalpha(sb.sgetc()) || isdigit(sb.sgetc()) || sb.sgetc() == '_' || sb.sgetc() == '~') {
-				lexeme += sb.rget();
-			}
-			if (lexverbose) std::cout << lexeme.size() << " Variable or keyword " << lexeme << std::endl;
-			this->append(lexeme, lex_type::Keyword);
+		else if (c == '/' && pos + 1 < length && buf[pos + 1] == '*') {
+			pos = find_comment_end(buf, pos + 2, length);
+			pos = (pos == length ? length : pos + 2);
+			if (lexverbose) std::cout << pos - start << " Multiline comment " << text.substr(start, pos - start) << std::endl;
+			this->append(start, pos, lex_type::Comment);
+		}
+		else if (c == '/' && pos + 1 < length && buf[pos + 1] == '/') {
+			pos = find_newline(buf, pos, length);
+		}
+		else if (is_class(c, CC_IdentStart)) {
+			pos = skip_ident(buf, pos + 1, length);
+			if (lexverbose) std::cout << pos - start << " Variable or keyword " << text.substr(start, pos - start) << std::endl;
+			this->append(start, pos, lex_type::Keyword);
 		}
-		else if (sb.sgetc() == '#') {
-			lexeme = sb.rget();
-			while (isalpha(sb.sgetc())) {
-				lexeme += sb.rget();
+		else if (c == '#') {
+			pos++;
+			while (pos < length && is_class(buf[pos], CC_Alpha)) {
+				pos++;
 			}
-			this->append(lexeme, lex_type::Unspecified);
+			this->append(start, pos, lex_type::Unspecified);
 		}
-		else if (isdigit(sb.sgetc())) {
-			while (isdigit(sb.sgetc()) || sb.sgetc() == '.') {
-				lexeme += sb.rget();
+		else if (is_class(c, CC_Digit)) {
+			while (pos < length && (is_class(buf[pos], CC_Digit) || buf[pos] == '.')) {
+				pos++;
 			}
-			if (lexverbose) std::cout << lexeme.size() << " Numeric literal " << lexeme << std::endl;
-			this->append(lexeme, lex_type::Number);
+			if (lexverbose) std::cout << pos - start << " Numeric literal " << text.substr(start, pos - start) << std::endl;
+			this->append(start, pos, lex_type::Number);
 		}
-		else if (sb.pos() < length - 1 && isoperator(sb.peek(2)) ) {
-			lexeme = sb.gets(2);
-			if (lexverbose) std::cout << lexeme.size() << " Double character operator " << lexeme << std::endl;
-			this->append(lexeme, lex_type::Operator);
+		else if (pos + 1 < length && is_twoc_operator(c, buf[pos + 1])) {
+			pos += 2;
+			if (lexverbose) std::cout << 2 << " Double character operator " << text.substr(start, 2) << std::endl;
+			this->append(start, pos, lex_type::Operator);
 		}
-		else if (isoperator(sb.sgetc())) {
-			lexeme = sb.rget();
-			if (lexverbose) std::cout << lexeme.size() << " Single character operator " << lexeme << std::endl;
-			this->append(lexeme, lex_type::Operator);
+		else if (is_class(c, CC_Operator)) {
+			pos++;
+			if (lexverbose) std::cout << 1 << " Single character operator " << text.substr(start, 1) << std::endl;
+			this->append(start, pos, lex_type::Operator);
 		}
-		else if (isspace(sb.sgetc())) {
-			lexeme = sb.rget();
-			while (isspace(sb.sgetc())) {
-				lexeme += sb.rget();
-			}
-			std::string wspace("");
-			for (auto l : lexeme) {
-		 		switch (l) {
-		            case '\a':  wspace += "\\a";        break;
-		            case '\b':  wspace += "\\b";        break;
-		            case '\f':  wspace += "\\f";        break;
-		            case '\n':  wspace += "\\n";        break;
-		            case '\r':  wspace += "\\r";        break;
-		            case '\t':  wspace += "\\t";        break;
-		            case '\v':  wspace += "\\v";        break;
-		            case ' ' :  wspace += ".";		    break;
-		            default  :	wspace += l;		    break;
+		else if (is_class(c, CC_Space)) {
+			pos = skip_space(buf, pos + 1, length);
+			if (lexverbose) {
+				std::string wspace("");
+				for (auto l : text.substr(start, pos - start)) {
+			 		switch (l) {
+			            case '\a':  wspace += "\\a";        break;
+			            case '\b':  wspace += "\\b";        break;
+			            case '\f':  wspace += "\\f";        break;
+			            case '\n':  wspace += "\\n";        break;
+			            case '\r':  wspace += "\\r";        break;
+			            case '\t':  wspace += "\\t";        break;
+			            case '\v':  wspace += "\\v";        break;
+			            case ' ' :  wspace += ".";		    break;
+			            default  :	wspace += l;		    break;
+					}
 				}
+				std::cout << pos - start << " Whitespace " << wspace << std::endl;
 			}
-			if (lexverbose) std::cout << lexeme.size() << " Whitespace " << wspace << std::endl;
-			this->append(lexeme, lex_type::WSpace);
+			this->append(start, pos, lex_type::WSpace);
+		}
+		else if (c == '\\') {
+			pos++;
+			while (pos < length && is_class(buf[pos++], CC_Space)) {}
 		}
-		else if (sb.sgetc() == '\\') {
-			sb.sbumpc();
-			while(isspace(sb.rget())) {}
+		else if (c == ';') {
+			pos++;
+			this->append(start, pos, lex_type::Operator);
 		}
-		else if (sb.sgetc() == ';') {
-			lexeme = sb.rget();
-			this->append(lexeme, lex_type::Operator);
+		else {
+			std::string problem(1, c);
+	 		switch (c) {
+	            case '\a':  problem = "\\a";        break;
+	            case '\b':  problem = "\\b";        break;
+	            case '\f':  problem = "\\f";        break;
+	            case '\n':  problem = "\\n";        break;
+	            case '\r':  problem = "\\r";        break;
+	            case '\t':  problem = "\\t";        break;
+	            case '\v':  problem = "\\v";        break;
+	            default  :							break;
+	        }
+			std::cout << "Problem with character "+red << problem << res+" at index "+magenta << pos << res+" in the context "+red;
+			size_t s = pos > 10 ? pos - 10 : 0;
+			std::cout << text.substr(s, 20) << res << std::endl;
+			exit(1);
 		}
 	}
 }
 
-int Lexer::find_new_keywords(std::vector<std::string> &keywords) {
-	size_t size = lexemes.size();
-	int n, ctx_s, ctx_e = 0;
-	for (int ii = 0; ii < size; ii ++) {
-		if (contains(specifiers, lexemes[ii].lex)) lexemes[ii].isspecifier = true;
-		if (lexemes[ii].lex == "class") {
-			ctx_s = ii;
-			while (ii < size && (lexemes[++ii].type != lex_type::Keyword || lexemes[ii + 1].lex == "::") ) {}
-			if (ii < size) {
-				lexemes[ii].make(ctx_s, ii, lexemes);
-				n += add_kw(lexemes[ii], keywords);
+int Lexer::find_new_keywords(KeywordSet &keywords) {
+	int n = add_kws(found, keywords);
+	found.clear();
+	if (!terminated.empty()) {
+		std::cout << "Extraction of new keywords terminated: " << terminated;
+	}
+	return n;
+}
+
+int Lexer::extract(std::vector<LexContext> &found) {
+//--------------------------------------------------------------------
+// Moves the probable keywords extracted from the current file, 
+// along with their context, to the end of {found} in the order they
+// appear so they can be merged into the keyword set later (see 
+// add_kws). Returns the number of keywords found; if extraction 
+// stopped early the reason is left in {terminated}.
+//--------------------------------------------------------------------
+	size_t n = this->found.size();
+	found.insert(found.end(), std::make_move_iterator(this->found.begin()), 
+		std::make_move_iterator(this->found.end()));
+	this->found.clear();
+	return n;
+}
+
+void Lexer::step(size_t ii, const Token &tok, std::string_view lex) {
+//--------------------------------------------------------------------
+// Advances the keyword extraction by one token. 
+//
+// class      - the first keyword after the specifier which is not 
+//              followed by '::'
+// namespace  - stops at the first keyword or '{', only the latter
+//              can yield a keyword (the last one before '{')
+// typedef    - the last keyword before the terminating ';'
+//
+// Tokens consumed while resolving a specifier are not themselves
+// checked for specifiers.
+//--------------------------------------------------------------------
+	switch (state) {
+		case Scan:
+			break;
+		case Class:
+			if (tok.type == lex_type::Keyword) {
+				candidate = ii;
+				candidate_tok = tok;
+				state = ClassName;
 			}
-			else {
-				std::cout << "Extraction of new keywords terminated: ";
-				std::cout << "no valid keyword found for specifier.\n";
-				return 0;
+			return;
+		case ClassName:
+			if (lex == "::") {
+				state = Class;
+				return;
 			}
-		}
-		else if  (lexemes[ii].lex == "namespace") {
-			ctx_s = ii;
-			while (ii < size && lexemes[++ii].lex != "{" && lexemes[ii].type != lex_type::Keyword) {}
-			if (ii < size) {
-				if (lexemes[ii].lex == "{")  {
-					while (lexemes[--ii].type != lex_type::Keyword) {}
-					if (lexemes[ii].lex != "namespace") {
-						lexemes[ii].make(ctx_s, ii, lexemes);
-						n += add_kw(lexemes[ii], keywords);	
+			emit(ii);
+			state = Scan;
+			break;
+		case Namespace:
+			if (lex == "{") {
+				// Everything since the specifier is rescanned, so the last
+				// keyword before '{' is the specifier itself unless one was
+				// found above.
+				if (src.view(candidate_tok.offset, candidate_tok.length) != "namespace") {
+					emit(ii);
+				}
+				if (ctxverbose) {
+					for (size_t jj = spec + 1; jj < ii; jj ++) {
+						std::string_view l = src.view(at(jj).offset, at(jj).length);
+						if (specifiers.contains(std::string(l))) at(jj).isspecifier = true;
 					}
 				}
+				state = Scan;
+				break;
 			}
-			else {
-				std::cout << "Extraction of new keywords terminated: ";
-				std::cout << "no valid keyword found for specifier.\n";
-				return 0;
+			if (tok.type == lex_type::Keyword) {
+				state = Scan;
 			}
-		}
-		else if (lexemes[ii].lex == "typedef") {
-			ctx_s = ii;
-			while (lexemes[ii].lex != ";") {
-				ii++;
-				if (ii >= size) {
-					std::cout << "Extraction of new keywords terminated: ";
-					std::cout << "no teminating semicolon for typedef sentence.\n";
-					return 0;
-				}
+			return;
+		case Typedef:
+			if (tok.type == lex_type::Keyword) {
+				candidate = ii;
+				candidate_tok = tok;
+			}
+			else if (lex == ";") {
+				emit(ii);
+				state = Scan;
 			}
-			ctx_e = ii;
-			while (lexemes[--ii].type != lex_type::Keyword) {}
-			lexemes[ii].make(ctx_s, ii, lexemes);
-			n += add_kw(lexemes[ii], keywords);
-			ii = ctx_e;
+			return;
+	}
+
+	if (ctxverbose && specifiers.contains(std::string(lex))) at(ii).isspecifier = true;
+	if (lex == "class" || lex == "namespace" || lex == "typedef") {
+		spec = ii;
+		spec_start = line_start;
+		candidate = ii;
+		candidate_tok = tok;
+		if (lex == "class") state = Class;
+		else if (lex == "namespace") state = Namespace;
+		else state = Typedef;
+	}
+}
+
+void Lexer::emit(size_t ii) {
+//--------------------------------------------------------------------
+// Records {candidate} as a found keyword. Its context runs to the
+// end of the candidate's line, so when contexts are requested it 
+// stays pending until the next line break has been lexed.
+//--------------------------------------------------------------------
+	found.push_back(LexContext(std::string(src.view(candidate_tok.offset, candidate_tok.length)), 
+		lex_type::Keyword, "", candidate_tok.file, candidate_tok.line));
+	if (!ctxverbose) return;
+	size_t highlight = std::string::npos;
+	for (size_t jj = spec_start; jj <= spec; jj ++) {
+		if (at(jj).isspecifier) {
+			highlight = jj;
+			break;
+		}
+	}
+	pending.push_back(Pending{found.size() - 1, spec_start, highlight});
+	for (size_t jj = candidate + 1; jj <= ii; jj ++) {
+		if (at(jj).newline) {
+			resolve(jj);
+			break;
 		}
 	}
+}
+
+void Lexer::resolve(size_t end) {
+	for (auto &p : pending) {
+		found[p.found].ctx = make_context(p.start, end, p.highlight);
+	}
+	pending.clear();
+}
+
+void Lexer::finish() {
+//--------------------------------------------------------------------
+// Called at the end of the file, resolves whatever extraction is 
+// still in progress.
+//--------------------------------------------------------------------
+	switch (state) {
+		case ClassName:
+			emit(candidate);
+			break;
+		case Class:
+		case Namespace:
+			terminated = "no valid keyword found for specifier.\n";
+			break;
+		case Typedef:
+			terminated = "no teminating semicolon for typedef sentence.\n";
+			break;
+		default:
+			break;
+	}
+	state = Scan;
+	if (!pending.empty()) resolve(ntokens - 1);
+}
+
+std::string Lexer::make_context(size_t start, size_t end, size_t highlight) {
+//--------------------------------------------------------------------
+// Builds the context string for tokens [start, end), with runs of 
+// line breaks collapsed and the {highlight} token in green.
+//--------------------------------------------------------------------
+	std::string context("    ");
+	for (size_t ii = start; ii < end; ii ++) {
+		std::string_view lex = src.view(at(ii).offset, at(ii).length);
+		if (ii == highlight) context += green;
+		if (at(ii).newline) {
+			size_t rs = lex.find('\n');
+			size_t re = lex.find_last_of('\n');
+			context += lex.substr(0, rs);
+			context += "\n    ";
+			context += lex.substr(re + 1);
+		}
+		else {
+			context += lex;
+		}
+		if (ii == highlight) context += white+bright;
+	}
+	return context+"\n";
+}
+
+int Lexer::add_kws(std::vector<LexContext> &found, KeywordSet &keywords) {
+	int n = 0;
+	for (auto &ctx : found) {
+		n += add_kw(ctx, keywords);
+	}
 	return n;
 }
 
-int Lexer::add_kw(LexContext ctx, std::vector<std::string> &keywords) {
-	std::string file = ctx.file.substr(ctx.file.find_last_of("/") + 1);
-	if (!contains(keywords, ctx.lex)) {
-		keywords.push_back(ctx.lex);
+int Lexer::add_kw(LexContext ctx, KeywordSet &keywords) {
+	std::string file = filename(ctx.file);
+	file = file.substr(file.find_last_of("/") + 1);
+	if (keywords.insert(ctx.lex, Parsed)) {
 		if (verbose) {
 			std::cout << std::left << "New keyword " << bright+cyan << std::setw(20) << ctx.lex << res+white 
 				<< " found on line " << magenta << std::setw(4) << ctx.line << res+white+" of file " 
@@ -239,31 +373,51 @@ int Lexer::add_kw(LexContext ctx, std::vector<std::string> &keywords) {
 	return 0;
 }
 
-std::vector<LexContext> Lexer::get_lexemes() {
-	return lexemes;
-}
-
-void Lexer::append(std::string &lexeme, lex_type type) {
-	if (lexeme == "") return;
-	lexemes.push_back(LexContext(lexeme, type, "", file, sb.line()));
-	lexeme = "";
-}
-
-bool Lexer::isoperator(char c) {
-	return contains(onec_operators, std::string(1, c));
+int Lexer::intern(const std::string &file) {
+	int id;
+	#pragma omp critical(intern)
+	{
+		auto it = file_ids.find(file);
+		if (it == file_ids.end()) {
+			it = file_ids.emplace(file, filenames.size()).first;
+			filenames.push_back(file);
+		}
+		id = it->second;
+	}
+	return id;
 }
 
-bool Lexer::isoperator(std::string s) {
-	return contains(twoc_operators, s);
+std::string Lexer::filename(int id) {
+	std::string name;
+	#pragma omp critical(intern)
+	name = filenames[id];
+	return name;
 }
 
-int Lexer::get_length(std::string file) {
-	std::ifstream fp(file);
-	int length = 0;
-	char in;
-	while (fp.get(in)) {
-		length ++;
+void Lexer::append(size_t start, size_t end, lex_type type) {
+//--------------------------------------------------------------------
+// Feeds the lexeme [start, end) to the keyword extraction as a 
+// compact token, trimming the context window to what is still 
+// needed.
+//--------------------------------------------------------------------
+	if (end <= start) return;
+	std::string_view lex = src.view(start, end - start);
+	Token tok{start, end - start, src.line(end, newlines),
+		static_cast<uint32_t>(file_id), type, false, lex.find('\n') != std::string_view::npos};
+	size_t ii = ntokens++;
+	if (ctxverbose) window.push_back(tok);
+	step(ii, tok, lex);
+	if (tok.newline) {
+		if (!pending.empty()) resolve(ii);
+		line_start = ii + 1;
+	}
+	if (ctxverbose) {
+		size_t keep = line_start;
+		if (state != Scan) keep = std::min(keep, spec_start);
+		for (auto &p : pending) keep = std::min(keep, p.start);
+		while (base < keep && !window.empty()) {
+			window.pop_front();
+			base++;
+		}
 	}
-	return length;
 }
-
@@ -16,31 +16,72 @@
 
 class Lexer {
 private:
-	static std::vector<std::string> onec_operators;
-	static std::vector<std::string> twoc_operators;
+	static std::deque<std::string> filenames;
+	static std::unordered_map<std::string, int> file_ids;
 
-	std::vector<std::string> specifiers;
-	std::vector<LexContext> lexemes;
+	enum extract_state {
+		Scan,											// Looking for a specifier
+		Class,											// Looking for the class name
+		ClassName,										// Class name found unless followed by '::'
+		Namespace,										// Looking for the namespace name or '{'
+		Typedef											// Looking for the terminating ';'
+	};
+
+	struct Pending {
+		size_t found;									// Index into {found}
+		size_t start;									// First token of the context
+		size_t highlight;								// Specifier to highlight, if any
+	};
+
+	KeywordSet specifiers;
+	std::vector<LexContext> found;
 
 	std::string file;
-	RCStreamBuf sb;
+	int file_id = 0;
+	MappedFile src;
 
 	int ctx_depth = 5;
 
+	// Streaming extraction state, advanced one token at a time by 
+	// append(). Tokens are only retained in {window} when contexts 
+	// are requested, and then only back to the start of the oldest
+	// line a context still needs.
+	extract_state state = Scan;
+	std::deque<Token> window;
+	size_t base = 0;									// Token index of window.front()
+	size_t ntokens = 0;
+	size_t newlines = 0;								// Line lookup cursor, see MappedFile::line
+	size_t line_start = 0;								// First token of the current line
+	size_t spec = 0;									// Specifier being resolved
+	size_t spec_start = 0;								// First token of the specifier's line
+	size_t candidate = 0;
+	Token candidate_tok;
+	std::vector<Pending> pending;
+
+	std::string terminated;
+
+	void step(size_t ii, const Token &tok, std::string_view lex);
+	void emit(size_t ii);
+	void resolve(size_t end);
+	void finish();
+	Token& at(size_t ii) { return window[ii - base]; }
+
 public:
 	Lexer(std::vector<std::string> specifiers = {});
 
 	void lex(std::string file, std::string language);
 	void cpp_lex();
-	int find_new_keywords(std::vector<std::string> &keywords);
-	int add_kw(LexContext context, std::vector<std::string> &keywords);
-	std::string make_context(int start, int end);
-	std::vector<LexContext> get_lexemes();
-	void append(std::string &lexeme, lex_type type);
-
-	bool isoperator(char c);
-	bool isoperator(std::string s);
-	int get_length(std::string file);
+	int find_new_keywords(KeywordSet &keywords);
+	int extract(std::vector<LexContext> &found);
+	static int add_kws(std::vector<LexContext> &found, KeywordSet &keywords);
+	static int add_kw(LexContext context, KeywordSet &keywords);
+	static int intern(const std::string &file);
+	static std::string filename(int id);
+
+	std::string termination() const { return terminated; }
+	const MappedFile& source() const { return src; }
+	std::string make_context(size_t start, size_t end, size_t highlight);
+	void append(size_t start, size_t end, lex_type type);
 };
 
 #endif // LEXER_H
@@ -0,0 +1,142 @@
+/* mappedfile.c++
+ *
+ * William Miller
+ * Oct 17, 2026
+ *
+ */
+
+#include "mappedfile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(MappedFile &&other) {
+	*this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile &&other) {
+	if (this != &other) {
+		close();
+		_data = other._data;
+		_size = other._size;
+		_mtime = other._mtime;
+		_mapped = other._mapped;
+		_good = other._good;
+		_buffer = std::move(other._buffer);
+		_newlines = std::move(other._newlines);
+		other._data = nullptr;
+		other._size = 0;
+		other._mtime = 0;
+		other._mapped = false;
+		other._good = false;
+	}
+	return *this;
+}
+
+bool MappedFile::open(const std::string &path) {
+//--------------------------------------------------------------------
+// Maps {path} read-only. If mmap is unavailable for this file (e.g.
+// a pipe or special file) the contents are read into an owned
+// buffer instead. Empty files are valid and have no data. The
+// modification time is taken from the same descriptor as the data.
+//--------------------------------------------------------------------
+	close();
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd >= 0) {
+		struct stat st;
+		if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+			_size = st.st_size;
+			_mtime = int64_t(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+			if (_size == 0) {
+				_good = true;
+			}
+			else {
+				void* addr = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+				if (addr != MAP_FAILED) {
+					madvise(addr, _size, MADV_SEQUENTIAL);
+					_data = static_cast<const char*>(addr);
+					_mapped = true;
+					_good = true;
+				}
+			}
+		}
+		::close(fd);
+	}
+	if (!_good) {
+		std::ifstream f(path, std::ios::binary);
+		if (f) {
+			std::string contents((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+			_size = contents.size();
+			_buffer.reset(new char[_size > 0 ? _size : 1]);
+			std::memcpy(_buffer.get(), contents.data(), _size);
+			_data = _buffer.get();
+			_good = true;
+		}
+		else {
+			_size = 0;
+		}
+	}
+	index();
+	return _good;
+}
+
+void MappedFile::close() {
+	if (_mapped) {
+		munmap(const_cast<char*>(_data), _size);
+	}
+	_buffer.reset();
+	_newlines.clear();
+	_data = nullptr;
+	_size = 0;
+	_mtime = 0;
+	_mapped = false;
+	_good = false;
+}
+
+std::string_view MappedFile::view(size_t pos, size_t n) const {
+	if (pos >= _size) return std::string_view();
+	return std::string_view(_data + pos, std::min(n, _size - pos));
+}
+
+unsigned int MappedFile::line(size_t pos) const {
+//--------------------------------------------------------------------
+// One-based line number of offset {pos}, i.e. one more than the
+// number of newlines strictly before {pos}.
+//--------------------------------------------------------------------
+	return std::lower_bound(_newlines.begin(), _newlines.end(), pos) - _newlines.begin() + 1;
+}
+
+unsigned int MappedFile::line(size_t pos, size_t &hint) const {
+//--------------------------------------------------------------------
+// As line(pos) for callers walking forward through the file, {hint}
+// is the number of newlines already passed and is advanced in place.
+//--------------------------------------------------------------------
+	if (hint > _newlines.size() || (hint > 0 && _newlines[hint - 1] >= pos)) hint = 0;
+	while (hint < _newlines.size() && _newlines[hint] < pos) {
+		hint++;
+	}
+	return hint + 1;
+}
+
+unsigned int MappedFile::column(size_t pos) const {
+	auto nl = std::lower_bound(_newlines.begin(), _newlines.end(), pos);
+	if (nl == _newlines.begin()) return pos;
+	return pos - *(nl - 1) - 1;
+}
+
+void MappedFile::index() {
+	_newlines.clear();
+	const char* p = _data;
+	const char* end = _data + _size;
+	while (p < end && (p = static_cast<const char*>(std::memchr(p, '\n', end - p))) != nullptr) {
+		_newlines.push_back(p - _data);
+		p++;
+	}
+}
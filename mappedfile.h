@@ -0,0 +1,63 @@
+/* mappedfile.h
+ *
+ * William Miller
+ * Oct 17, 2026
+ *
+ * Read-only, memory-mapped view of a code file. Falls back to reading
+ * the whole file into memory when the file cannot be mapped. Lexemes
+ * are taken as std::string_view slices of the mapped buffer and line
+ * numbers are looked up from a precomputed index of newline offsets,
+ * so the lexer never has to copy or re-read the file.
+ *
+ */
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class MappedFile {
+public:
+	MappedFile() {}
+	MappedFile(const std::string &path) { open(path); }
+	~MappedFile() { close(); }
+
+	MappedFile(MappedFile &&other);
+	MappedFile& operator=(MappedFile &&other);
+
+	bool open(const std::string &path);
+	void close();
+
+	const char* data() const { return _data; }
+	size_t size() const { return _size; }
+	bool good() const { return _good; }
+	int64_t mtime() const { return _mtime; }
+
+	int at(size_t pos) const { return pos < _size ? static_cast<unsigned char>(_data[pos]) : EOF; }
+	std::string_view view(size_t pos, size_t n) const;
+
+	unsigned int line(size_t pos) const;
+	unsigned int line(size_t pos, size_t &hint) const;
+	unsigned int column(size_t pos) const;
+
+private:
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	void index();
+
+	const char* _data = nullptr;
+	size_t _size = 0;
+	int64_t _mtime = 0;								// Nanoseconds, as of open()
+	bool _mapped = false;
+	bool _good = false;
+	std::unique_ptr<char[]> _buffer;
+	std::vector<size_t> _newlines;
+};
+
+#endif // MAPPEDFILE_H
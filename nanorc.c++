@@ -16,14 +16,13 @@ bool verbose;
 bool lexverbose;
 bool ctxverbose;
 std::vector<std::string> files;
-std::vector<std::string> keywords;
-std::vector<std::string> ignored;
+KeywordSet keywords;
+KeywordSet ignored;
 std::string keywordColor;
+int ruleLength;
 std::vector<std::string> specifiers;
 
 static std::vector<std::string> extensions = {"h", "h++", "hpp", "c", "c++", "cpp"};
-static std::vector<std::string> rgx = {"[^A-Za-z0-9\\_]", "^", "[^A-Za-z0-9\\_]", "^"};
-static std::vector<std::string> sfx = {"[^A-Za-z0-9\\_]", "[^A-Za-z0-9\\_]", "$", "$"};
 
 static std::vector<std::string> cpp_types = {"bool", "int", "char", "true", "false", "float", 
 											  "double", "long", "signed", "unsigned"};
@@ -38,10 +37,15 @@ int main(int argn, char** argv) {
 	bool builtin;
 	bool recursive;
 	bool confirm;
+	bool nocache;
+	bool stats;
+	std::string stats_json;
+	int jobs;
 	std::string mode;
 	std::vector<std::string> to_add;
 	std::vector<std::string> to_remove;
 	std::vector<std::string> to_ignore;
+	std::vector<std::string> excludes;
 	po::options_description description("Allowed Options");
 	po::positional_options_description positional;
 
@@ -77,7 +81,20 @@ int main(int argn, char** argv) {
 				" keyword context output.")
 			("recursive,r", po::bool_switch()->default_value(false), "Enable recursive"
 				"searcing.") 
+			("exclude,e", po::value<std::vector<std::string> >()->multitoken(),
+				"Patterns (.gitignore style) of files and directories to skip when"
+				" searching recursively.")
 			("no-confirm,y", po::bool_switch()->default_value(false), "Disable confirm before write.") 
+			("jobs,j", po::value<int>(&jobs)->default_value(1), "Number of files to lex in"
+				" parallel, 0 for one per processor.")
+			("no-cache", po::bool_switch()->default_value(false), "Lex every file instead of"
+				" reusing the keywords cached for unchanged files.")
+			("rule-length", po::value<int>(&ruleLength)->default_value(1024), "Maximum length of"
+				" each keyword highlighting rule written to the rc file.")
+			("stats", po::bool_switch()->default_value(false), "Print the time spent and the"
+				" files, bytes, lexemes and keywords handled in each phase.")
+			("stats-json", po::value<std::string>(&stats_json), "Write the --stats figures as JSON"
+				" to the given file.")
 			("add", po::value<std::vector<std::string> >()->multitoken(),
 				"Add a given keyword or set of keywords to the rc file. [remove]"
 				" and [ignore] options will be ignored when [add] is specified.")
@@ -110,16 +127,20 @@ int main(int argn, char** argv) {
 	ctxverbose = vm["ctxverbose"].as<bool>();
 	recursive = vm["recursive"].as<bool>();
 	confirm = vm["no-confirm"].as<bool>();
+	nocache = vm["no-cache"].as<bool>();
+	stats = vm["stats"].as<bool>();
 	if (vm.count("files")) files = vm["files"].as<std::vector<std::string> >();
 	if (vm.count("specifiers")) specifiers = vm["specifiers"].as<std::vector<std::string> >();
 	if (vm.count("add")) to_add = vm["add"].as<std::vector<std::string> >();
 	if (vm.count("remove")) to_remove = vm["remove"].as<std::vector<std::string> >();
 	if (vm.count("ignore")) to_ignore = vm["ignore"].as<std::vector<std::string> >();
+	if (vm.count("exclude")) excludes = vm["exclude"].as<std::vector<std::string> >();
 	if (!lib && !user && !builtin) user = true;
 	if (lib && user && builtin) {
 		lib = false;
 		builtin = false;
 	}
+	auto start = RunStats::clock::now();
 	if (keywordColor == "default" && lib) keywordColor = "brightyellow";
 	if (keywordColor == "default" && user) keywordColor = "brightcyan";
 	if (keywordColor == "default" && builtin) keywordColor = "green";
@@ -147,14 +168,17 @@ int main(int argn, char** argv) {
 	}
 
 	std::string pref = "User";
-	if (std::filesystem::exists(ofile)) {
-		keywords = rcParse(ofile, mode);
+	RcDocument rc;
+	auto t0 = RunStats::clock::now();
+	if (rc.load(ofile)) {
+		keywords = rcParse(rc, mode);
+		runStats.add(RcParse, RunStats::since(t0), 1, rc.size(), 0, keywords.size());
 		if (lib) pref = "Library";
 		else if (builtin) pref = "Builtin";
 		if (keywords.size() != 0 && verbose) {
 			std::cout << "Current "+bright+pref+" Keyword"+res+white+" set is as follows.\n";
-			sort(keywords);
-			print_table(keywords, std::vector<bool>(), mode);
+			keywords.sort();
+			print_table(keywords, mode);
 		}
 		else {
 			if (verbose) {
@@ -162,19 +186,14 @@ int main(int argn, char** argv) {
 			}
 		}
 	}
-	std::vector<bool> changed;
-	for (int ii = 0; ii < keywords.size(); ii ++) {
-		changed.push_back(false);
-	}
 
 	int nkeywords = keywords.size();
 	int count;
+	RCCache cache;
 	if (!to_add.empty()) {
 		count = 0;
 		for (auto a : to_add) {
-			if (!contains(keywords, a)) {
-				keywords.push_back(a);
-				changed.push_back(true);
+			if (keywords.insert(a, Manual)) {
 				count++;
 			}
 		}
@@ -182,12 +201,8 @@ int main(int argn, char** argv) {
 	}
 	else if (!to_remove.empty()) {
 		count = 0;
-		for (int ii = 0; ii < to_remove.size(); ii ++) {
-			std::string r = to_remove[ii];
-			if (contains(keywords, r)) {
-				int ridx = std::find(keywords.begin(), keywords.end(), r) - keywords.begin();
-				keywords.erase(keywords.begin() + ridx);
-				changed.erase(changed.begin() + ridx);
+		for (auto r : to_remove) {
+			if (keywords.erase(r)) {
 				count++;
 			}
 		}
@@ -196,56 +211,52 @@ int main(int argn, char** argv) {
 	else if (!to_ignore.empty()) {
 		count = 0;
 		for (auto i : to_ignore) {
-			if (!contains(ignored, i)) {
-				ignored.push_back(i);
+			if (ignored.insert(i, Manual)) {
 				count ++;
 			}
 		}
 		std::cout << "Added "+bright+magenta << count << res+white+" keywords to be ignored." << std::endl;
-		return 0;
+		rc.set_ignored(ignored);
+		return rc.save() ? 0 : 1;
 	}
 	else {		
+		if (!nocache) {
+			cache = RCCache(RCCache::locate(ofile, mode), specifiers);
+			cache.load();
+			cache.enabled = !lexverbose && !ctxverbose;	// Cached files have no lexemes or context to show
+		}
+		if (jobs <= 0) jobs = omp_get_num_procs();
+		if (lexverbose) jobs = 1;							// Per-lexeme output must stay in order
+		Walker walker(extensions, excludes);
 		if (recursive) {
-			files = recurse(files);
-			std::cout << "Recursive search found the following files:\n";
-			for (int ii = 0; ii < files.size(); ii ++) {
-				std::cout << bright+yellow << files[ii] << res+white << std::endl;
-			}
+			extract(walker, files, jobs, cache);
 		}
 		else {
 			auto f = std::begin(files);
 			while (f != std::end(files)) {
-				if (!contains(extensions, tolower(f->substr(f->find_last_of(".") + 1))) ) {
+				if (!walker.accept(*f)) {
 					f = files.erase(f);
 				}
 				else {
 					f++;
 				}
 			}
+			extract(files, jobs, cache);
 		}
-		Lexer lexer = Lexer(specifiers);
-		int nchanged;
-		for (auto file: files) {
-			if (std::filesystem::exists(file)) {
-				std::cout << "Lexing "+yellow << file << res+white << " ... " << std::flush;
-				if (verbose) std::cout << "\n";
-				lexer.lex(file, "c++");
-				nchanged = lexer.find_new_keywords(keywords);
-				if (!verbose) std::cout << bright+green+" complete"+res+white+".\n" << std::flush;
-			}
-		}
-		int unchanged = changed.size();
-		for (int ii = unchanged; ii < keywords.size(); ii ++) {
-			changed.push_back(true);
+		if (cache.withdraw(keywords) && verbose) {
+			std::cout << "Withdrew "+bright+magenta << cache.withdrawn << res+white+" keywords no longer"
+				" found in any cached file.\n";
 		}
 		std::cout << "After parsing "+bright+magenta << files.size() << res+white+" files, ";
 	}
 
-	sort(keywords, changed);
+	keywords.sort();
 
-	if (nkeywords != keywords.size()) {
+	bool written = false;
+	bool declined = false;
+	if (nkeywords != keywords.size() || cache.withdrawn) {
 		std::cout << "the "+bright+pref+" Keyword"+res+white+" set is now\n";
-		print_table(keywords, changed, mode);
+		print_table(keywords, mode);
 
 		if (!confirm) {
 			std::string in;
@@ -254,11 +265,14 @@ int main(int argn, char** argv) {
 					<< std::flush;
 			std::cin >> in;
 			if (tolower(in) == "y" || tolower(in) == "yes") {
-				write(ofile, mode);
+				written = write(rc, mode);
+			}
+			else {
+				declined = true;
 			}
 		}
 		else {
-			write(ofile, mode);
+			written = write(rc, mode);
 		}
 		
 	}
@@ -272,308 +286,156 @@ int main(int argn, char** argv) {
 			std::cout << "The "+bright+pref+" Keyword"+res+white+" set is unchanged." << std::endl;
 		}
 	}
-	
+
+	if (written) cache.own(keywords);
+	if (!declined) cache.save();						// The cache describes the rc file as written
+	runStats.wall = RunStats::since(start);
+	runStats.jobs = jobs;
+	runStats.counter("files", files.size());
+	runStats.counter("cache_hits", cache.hits);
+	runStats.counter("cache_misses", cache.misses);
+	runStats.counter("keywords_withdrawn", cache.withdrawn);
+	if (stats) {
+		runStats.print(std::cout);
+		std::cout << "Extraction cache: " << cache.hits << " hits, " << cache.misses << " misses, "
+			<< cache.withdrawn << " keywords withdrawn." << std::endl;
+	}
+	if (!stats_json.empty()) {
+		std::ofstream f(stats_json);
+		runStats.json(f);
+		if (!f) std::cout << "Unable to write "+yellow << stats_json << res+white << std::endl;
+	}
 }
 
-std::vector<std::string> recurse(std::vector<std::string> paths) {
-	std::vector<std::string> files;
-	std::error_code ec;
-	size_t pos;
-	for (int ii = 0; ii < paths.size(); ii ++) {
-		try {
-			if (std::filesystem::exists(paths[ii])) {
-				if (std::filesystem::is_directory(paths[ii])) {
-					if (verbose) {
-						std::cout << bright+red << paths[ii] << res+white;
-						std::cout << " is directory, searching...\n";
-					}
-					std::filesystem::recursive_directory_iterator iter(paths[ii]);
-					std::filesystem::recursive_directory_iterator end;
-						// Default constructor points to std::end
-					while (iter != end) {
-						if (verbose) {
-							std::cout << "    " << iter->path().string() << std::endl;
-						}
-						pos = iter->path().string().find_last_of(".") + 1;
-						std::cout << tolower(iter->path().string().substr(pos)) << std::endl;
-						if (pos != std::string::npos && contains(extensions, tolower(iter->path().string().substr(pos))) ) {
-							files.push_back(iter->path().string());	
-						}
-						iter.increment(ec);
-						if (ec) {
-							std::cout << "Error while accessing " << 
-								iter->path().string() << " -- " << ec.message() << "\n";
-								
-						}
-					}
-					
-				}
-				else {
-					pos = paths[ii].find_last_of(".") + 1;
-					if (pos != std::string::npos && (std::find(extensions.begin(), 
-						  extensions.end(), tolower(paths[ii].substr(pos))) 
-						  != extensions.end())) {
-						files.push_back(paths[ii]);
-					}
-				}
+void extract(std::vector<std::string> files, int jobs, RCCache &cache) {
+//--------------------------------------------------------------------
+// Lexes {files} and extracts their keywords on {jobs} threads, each
+// file with its own Lexer. The keywords found are merged into the
+// global set in file order afterwards, so the resulting set and the
+// reporting are the same as for a serial run. Files which are 
+// unchanged since they were cached are not lexed at all.
+//--------------------------------------------------------------------
+	int nfiles = files.size();
+	if (jobs == 1) {
+		Lexer lexer = Lexer(specifiers);
+		for (auto file: files) {
+			if (std::filesystem::exists(file)) {
+				extract(lexer, file, cache);
 			}
 		}
-		catch (std::system_error &error) {
-			std::cerr << "Exception -- " << error.what();
-		}
-		catch (...) {
-			std::cerr << "Exception -- " << " Unknown Exception caught on line " <<
-				__LINE__ << " in file "+bright+yellow << __FILE__ << res+white+"." 
-				<< std::endl;
-		}
+		return;
 	}
 
-	return files;
-}
+	std::vector<std::vector<LexContext> > found(nfiles);
+	std::vector<std::string> terminated(nfiles);
+	std::vector<char> exists(nfiles);
 
-std::vector<std::string> rcParse(std::string rcfile, std::string mode) {
-	std::ifstream file(rcfile);
-	std::string line("");
-	std::vector<std::string> keywords;
-	std::string key = "## custom keywords";
-	if (verbose) std::cout << "Parsing existing keywords... \n"; 
-	
-	if (mode == "lib") key = "## library keywords";
-	else if (mode == "builtin") key = "## builtin keywords";
-	
-	while (true) {
-		if (std::getline(file,line)) {
-			size_t start = line.find_first_not_of(" \t");
-			if (start != std::string::npos) {
-				line = line.substr(start); 
-			}
-			if (tolower(line) == "## ignore") {
-				while (true) {
-					std::getline(file, line);
-					if (line.find("#") != std::string::npos) {
-						line = line.substr(line.find("#")).substr(line.find_first_not_of(" \t"));
-						if (line.find("\n") != std::string::npos) {
-							line = line.substr(line.find("\n") - 1);
-						}
-						ignored.push_back(line);
-					}
-					else break;
-				}
-			}
-			if (tolower(line) == key) {
-				std::vector<std::string> parsed;
-				while (true) {
-					std::getline(file, line);
-					size_t start = line.find_first_not_of(" \t");
-					size_t end = line.find_first_of("\"");
-					std::string prefix("");
-					if (start != std::string::npos && 
-						end != std::string::npos) {
-						prefix = line.substr(start, end-start-1);
-					}
-					else if (line.length() > start && line[start] == '#') continue;	
-					else {
-						if (verbose) std::cout << "End of existing keywords found - no matching quotations.\n";
-						break;
-					}
-					if (prefix == "color "+keywordColor) {
-						parsed = lineParse(line, keywords);
-						keywords.insert(keywords.end(), 
-							parsed.begin(), parsed.end());
-					}
-					else {
-						if (verbose) {
-							std::cout << "End of existing keywords found - "
-									 "prefix ("+prefix+") does not match 'color "
-									 +keywordColor+"'.\n"; 
-						}
-						break; 
-					}
-				}
-				break;
-			}
+	#pragma omp parallel for schedule(dynamic) num_threads(jobs)
+	for (int ii = 0; ii < nfiles; ii ++) {
+		exists[ii] = std::filesystem::exists(files[ii]);
+		if (exists[ii]) {
+			Lexer lexer = Lexer(specifiers);
+			extract(lexer, files[ii], found[ii], terminated[ii], cache);
 		}
-		else {
-			break;
-		}	
 	}
-	file.close();
-	return keywords;
-}
 
-std::vector<std::string> lineParse(std::string line, std::vector<std::string> keywords) {
-	std::vector<std::string> parsed;
-	size_t start = line.find_first_of("(")+1;
-	size_t end = line.find_last_of(")");
-	size_t pos = 0;
-	std::string token;
-	if (start != std::string::npos && end != std::string::npos) {
-		line = line.substr(start, end-start);
-		while ((pos = line.find("|")) != std::string::npos) {
-		    token = line.substr(0, pos);
-		    line.erase(0, pos + 1);
-		    if (std::find(keywords.begin(), keywords.end(), token) == keywords.end()) {
-		    	if (verbose) {
-		    		std::cout << "Keyword "+bright+magenta+token+res+white+" added.\n";
-		    	}
-		    	parsed.push_back(token);
-		    }
-		    else {
-		    	if (verbose) {
-		    		std::cout << "Duplicate keyword "+bright+magenta+token+res+white
-		    			+" found.\n";
-		    	}
-		    }
-		}
-		token = line;		
-		if (std::find(keywords.begin(), keywords.end(), token) == keywords.end()) {
-			if (verbose) {
-		    	std::cout << "Keyword "+bright+magenta+token+res+white+" added.\n";
-			}
-		    parsed.push_back(token);
-		}
-		else {
-			if (verbose) {
-		    	std::cout << "Duplicate keyword "+bright+magenta+token+res+white
-		    		+" found.\n";
-			}
+	for (int ii = 0; ii < nfiles; ii ++) {
+		if (exists[ii]) {
+			merge(files[ii], found[ii], terminated[ii]);
 		}
 	}
-	return parsed;
 }
 
-void write(std::string filename, std::string mode) {
-	std::ifstream file(filename);
-	std::string line("");
-	std::string orig("");
-	std::string key = "## custom keywords";
-	std::vector<std::string> lines;\
-	
-	if (mode == "lib") key = "## library keywords";
-	else if (mode == "builtin") key = "## builtin keywords";
-	
-	while (std::getline(file, line)) {
-		orig = line;
-		size_t start = line.find_first_not_of(" \t");
-		if (start != std::string::npos) {
-			line = line.substr(start);
-		}
-		if (tolower(line) == "## ignore") {
-			while (true) {
-				std::getline(file, line);
-				if (line.find("#") == std::string::npos) {
-					lines.push_back("");
-					break;
-				}
-			}
-			for (auto i : ignored) {
-				lines.push_back("# "+i);
-			}
-		}
-		if (tolower(line) == key) {
-			lines.push_back(line);
-			while (true) {
-				std::getline(file, line);
-				start = line.find_first_not_of(" \t");
-				size_t end = line.find_first_of("\"");
-				std::string prefix("");
-				if (start != std::string::npos && end != std::string::npos) {
-					prefix = line.substr(start, end-start-1);
-				}
-				else if (line.length() > start && line[start] == '#') {
-					continue;
-				}
-				else {
-					break;
-				}
-				if (prefix == "color "+keywordColor) {
-					while (prefix == "color "+keywordColor) {
-						std::getline(file, line);
-						start = line.find_first_not_of(" \t");
-						end = line.find_first_of("\"");
-						prefix = "";
-						if (start != std::string::npos && end != std::string::npos) {
-							prefix = line.substr(start, end-start-1);
-						}
-						else if (line.length() > start && line[start] =='#') {
-							continue;
-						}
-						else {
-							break;
-						}
-					}
-					std::string out("");
-					for (int kk = 0; kk < rgx.size(); kk ++) {
-						std::string prefix("\tcolor "+keywordColor+" \""
-										   +rgx[kk]+"(");
-						std::string suffix(")"+sfx[kk]+"\"");
-						out = prefix;
-						for (int ii = 0; ii < keywords.size(); ii ++) {
-							if (ii % 10 != 0) {
-								out = out+"|";
-							}
-							out = out+keywords[ii];
-							if (ii % 10 == 9) {
-								lines.push_back(out+suffix);
-								out = prefix;
-							}
-						}
-						if (out != prefix) lines.push_back(out+suffix);
-						if (mode == "builtin") lines.push_back(prefix+"const"+suffix);
-					}
-					lines.push_back("");
-					break;
-				}
-			}
-		}
-		else {
-			lines.push_back(orig);
-		}
+void extract(Walker &walker, std::vector<std::string> &paths, int jobs, RCCache &cache) {
+//--------------------------------------------------------------------
+// Walks {paths} and lexes each code file as soon as the walker finds
+// it. In parallel the results are merged per path in the order a 
+// serial walk would have visited them. {paths} is replaced by the 
+// files found.
+//--------------------------------------------------------------------
+	std::vector<std::string> roots = paths;
+	paths.clear();
+	if (jobs == 1) {
+		Lexer lexer = Lexer(specifiers);
+		walker.walk(roots, 1, [&](const std::string &file) {
+			paths.push_back(file);
+			extract(lexer, file, cache);
+		});
+		return;
 	}
-	std::ofstream ofile(filename);
-	for (auto line : lines) {
-		ofile << line << "\n";
+
+	struct Result {
+		std::string file;
+		std::vector<LexContext> found;
+		std::string terminated;
+	};
+	for (auto &root : roots) {
+		std::vector<Result> results;
+		walker.walk({root}, jobs, [&](const std::string &file) {
+			Result r;
+			r.file = file;
+			Lexer lexer = Lexer(specifiers);
+			extract(lexer, file, r.found, r.terminated, cache);
+			#pragma omp critical(results)
+			results.push_back(std::move(r));
+		});
+		std::sort(results.begin(), results.end(), [](const Result &a, const Result &b) {
+			return Walker::order(a.file, b.file);
+		});
+		for (auto &r : results) {
+			paths.push_back(r.file);
+			merge(r.file, r.found, r.terminated);
+		}
 	}
-	
-	file.close();
-	return;
 }
 
-bool contains(std::vector<std::string> v, std::string item) {
-	return (std::find(v.begin(), v.end(), item) != v.end());
+void extract(Lexer &lexer, std::string file, RCCache &cache) {
+//--------------------------------------------------------------------
+// Serial extraction of a single file, merged immediately.
+//--------------------------------------------------------------------
+	std::vector<LexContext> found;
+	std::string terminated;
+	std::cout << "Lexing "+yellow << file << res+white << " ... " << std::flush;
+	if (verbose) std::cout << "\n";
+	extract(lexer, file, found, terminated, cache);
+	auto t0 = RunStats::clock::now();
+	int n = Lexer::add_kws(found, keywords);
+	runStats.add(Merge, RunStats::since(t0), 1, 0, 0, n);
+	if (!terminated.empty()) {
+		std::cout << "Extraction of new keywords terminated: " << terminated;
+	}
+	if (!verbose) std::cout << bright+green+" complete"+res+white+".\n" << std::flush;
 }
 
-void sort(std::vector<std::string> &keywords) {
-	for (int ii = 0; ii < keywords.size(); ii ++) {
-		if (keywords[ii][0] == char(0)) keywords.erase(keywords.begin() + ii);
-		for (int jj = ii; jj < keywords.size(); jj ++) {
-			if (keywords[ii].compare(keywords[jj]) > 0) {
-				std::swap(keywords[ii], keywords[jj]);
-			}
-		}
+void extract(Lexer &lexer, std::string file, std::vector<LexContext> &found, std::string &terminated, 
+		RCCache &cache) {
+//--------------------------------------------------------------------
+// Appends the keywords of {file} to {found}, from the cache if the 
+// file is unchanged and by lexing it otherwise.
+//--------------------------------------------------------------------
+	size_t from = found.size();
+	auto t0 = RunStats::clock::now();
+	bool cached = cache.fetch(file, found);
+	double dt = RunStats::since(t0);
+	if (!cached) {
+		lexer.lex(file, "c++");
+		t0 = RunStats::clock::now();
+		lexer.extract(found);
+		cache.store(file, lexer.source(), found, from);
+		terminated = lexer.termination();
+		dt += RunStats::since(t0);
 	}
-	return;
+	runStats.add(Extract, dt, 1, 0, 0, found.size() - from);
 }
 
-void sort(std::vector<std::string> &keywords, std::vector<bool> &changed) {
-	int nkeywords = keywords.size();
-	int nchanged = changed.size();
-	if (nchanged != nkeywords) {
-		std::cout << "There was a problem, the number of keywords does not";
-		std::cout << " match the size of the change indexor" << std::endl;
-		return;
+void merge(std::string file, std::vector<LexContext> &found, std::string terminated) {
+	std::cout << "Lexing "+yellow << file << res+white << " ... " << std::flush;
+	if (verbose) std::cout << "\n";
+	auto t0 = RunStats::clock::now();
+	int n = Lexer::add_kws(found, keywords);
+	runStats.add(Merge, RunStats::since(t0), 1, 0, 0, n);
+	if (!terminated.empty()) {
+		std::cout << "Extraction of new keywords terminated: " << terminated;
 	}
-	for (int ii = 0; ii < keywords.size(); ii ++) {
-		if (keywords[ii][0] == char(0)) keywords.erase(keywords.begin() + ii);
-		for (int jj = ii; jj < keywords.size(); jj ++) {
-			if (keywords[ii].compare(keywords[jj]) > 0) {
-				std::swap(keywords[ii], keywords[jj]);
-				if (ii < nchanged && jj < nchanged) {
-					std::swap(changed[ii], changed[jj]);
-				}
-			} 
-		}
-	}
-	return;
+	if (!verbose) std::cout << bright+green+" complete"+res+white+".\n" << std::flush;
 }
-
@@ -17,10 +17,17 @@
 
 #include <algorithm>
 #include <cctype>
+#include <chrono>
+#include <cstring>
+#include <deque>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
 #include <string>
+#include <unordered_set>
 #include <vector>
 #include <cctype>
 #include <experimental/filesystem>
@@ -28,13 +35,22 @@
 #include <boost/program_options.hpp>
 
 #include <ncurses.h>
+#include <omp.h>
 #include <unistd.h>
 
 #include "colors.h"
+#include "keywordset.h"
 #include "rcio.h"
 #include "rcstreambuf.h"
+#include "mappedfile.h"
+#include "charclass.h"
 #include "lexcontext.h"
 #include "lexer.h"
+#include "rccache.h"
+#include "rcdocument.h"
+#include "rcregex.h"
+#include "stats.h"
+#include "walker.h"
 
 namespace po = boost::program_options;
 namespace std{
@@ -42,20 +58,21 @@ namespace std{
 
 };
 
-extern std::vector<std::string> keywords;
+extern KeywordSet keywords;
+extern KeywordSet ignored;
+extern std::string keywordColor;
+extern int ruleLength;
 extern bool verbose;
 extern bool lexverbose;
 extern bool ctxverbose;
 
-std::vector<std::string> recurse(std::vector<std::string> paths); 
-std::vector<std::string> rcParse(std::string rcfile, std::string mode);
-std::vector<std::string> lineParse(std::string line, std::vector<std::string>);
-
-void write(std::string filename, std::string mode);
-
-bool contains(std::vector<std::string> v, std::string item);					// Return if {v} contains {item}
-
-void sort(std::vector<std::string> &keywords);
-void sort(std::vector<std::string> &keywords, std::vector<bool> &changed);
+class RCCache;
+class Walker;
+void extract(std::vector<std::string> files, int jobs, RCCache &cache);
+void extract(Walker &walker, std::vector<std::string> &paths, int jobs, RCCache &cache);
+void extract(Lexer &lexer, std::string file, RCCache &cache);
+void extract(Lexer &lexer, std::string file, std::vector<LexContext> &found, std::string &terminated, 
+			 RCCache &cache);
+void merge(std::string file, std::vector<LexContext> &found, std::string terminated);
 
 #endif // NANORC_H
@@ -0,0 +1,274 @@
+/* rccache.c++
+ *
+ * William Miller
+ * Oct 17, 2026
+ *
+ * The cache is a plain text file,
+ *
+ *     nanorc-cache 2
+ *     specifiers <specifier> ...
+ *     owned <keyword> ...
+ *     file <size> <mtime> <hash> <canonical path>
+ *     kw <line> <keyword>
+ *     ...
+ *
+ * with one 'kw' line per keyword extracted from the preceding file.
+ * Version 1 caches keyed files on their absolute paths, which may hold
+ * one file several times, and are discarded.
+ *
+ */
+
+#include "rccache.h"
+
+#include <sys/stat.h>
+
+RCCache::RCCache(std::string path, std::vector<std::string> specifiers) {
+	this->path = path;
+	std::sort(specifiers.begin(), specifiers.end());
+	for (auto &s : specifiers) {
+		this->specifiers += " "+s;
+	}
+}
+
+std::string RCCache::locate(std::string rcfile, std::string mode) {
+//--------------------------------------------------------------------
+// Returns the cache file for the {mode} keywords of {rcfile} under 
+// $XDG_CACHE_HOME (or ~/.cache), creating the directory if needed.
+// Returns an empty path, which disables caching, on failure.
+//--------------------------------------------------------------------
+	std::string dir;
+	if (getenv("XDG_CACHE_HOME") && *getenv("XDG_CACHE_HOME")) dir = getenv("XDG_CACHE_HOME");
+	else if (getenv("HOME")) dir = std::string(getenv("HOME"))+"/.cache";
+	else return "";
+	dir += "/nanorc-mngr";
+	std::error_code ec;
+	std::filesystem::create_directories(dir, ec);
+	if (!std::filesystem::is_directory(dir)) return "";
+
+	std::string id = key(rcfile)+":"+mode;
+	std::ostringstream name;
+	name << dir << "/" << std::hex << std::setw(16) << std::setfill('0') << hash(id.data(), id.size()) << ".cache";
+	return name.str();
+}
+
+uint64_t RCCache::hash(const char* data, size_t size) {
+//--------------------------------------------------------------------
+// 64 bit FNV-1a
+//--------------------------------------------------------------------
+	uint64_t h = 14695981039346656037ULL;
+	for (size_t ii = 0; ii < size; ii ++) {
+		h ^= static_cast<unsigned char>(data[ii]);
+		h *= 1099511628211ULL;
+	}
+	return h;
+}
+
+std::string RCCache::key(const std::string &file) {
+//--------------------------------------------------------------------
+// The canonical path of {file}, so that every spelling of the same
+// file (./src/a.h, src/a.h, a symlink) shares one entry. Files which
+// no longer exist fall back to their absolute path.
+//--------------------------------------------------------------------
+	std::error_code ec;
+	auto canonical = std::filesystem::canonical(file, ec);
+	if (!ec) return canonical.string();
+	return std::filesystem::absolute(file).string();
+}
+
+bool RCCache::load() {
+//--------------------------------------------------------------------
+// Reads the cache from {path}. A cache of another version or written
+// with a different set of specifiers is discarded entirely. The paths
+// are trusted to be keys already, so loading never touches the files.
+//--------------------------------------------------------------------
+	if (path.empty()) return false;
+	std::ifstream f(path);
+	std::string line;
+	if (!std::getline(f, line)) return false;
+	if (line != "nanorc-cache 2") {
+		if (verbose) std::cout << "Extraction cache format changed, discarding extraction cache.\n";
+		return false;
+	}
+	if (!std::getline(f, line) || line != "specifiers"+specifiers) {
+		if (verbose) std::cout << "Keyword specifiers changed, discarding extraction cache.\n";
+		return false;
+	}
+	Entry* entry = nullptr;
+	while (std::getline(f, line)) {
+		std::istringstream in(line);
+		std::string tag;
+		in >> tag;
+		if (tag == "owned") {
+			std::string kw;
+			while (in >> kw) {
+				owned.insert(kw);
+			}
+		}
+		else if (tag == "file") {
+			Entry e;
+			std::string file;
+			in >> e.size >> e.mtime >> std::hex >> e.hash >> std::dec;
+			in.get();
+			std::getline(in, file);
+			if (in.fail() || file.empty()) {
+				entry = nullptr;
+				continue;
+			}
+			entry = &(entries[file] = e);
+		}
+		else if (tag == "kw" && entry) {
+			std::pair<std::string, int> kw;
+			if (in >> kw.second >> kw.first) entry->keywords.push_back(kw);
+		}
+	}
+	return true;
+}
+
+bool RCCache::save() {
+//--------------------------------------------------------------------
+// Writes the cache to a temporary file which then replaces {path}, 
+// so an interrupted run leaves the previous cache intact.
+//--------------------------------------------------------------------
+	if (path.empty()) return false;
+	std::string tmp = path+".tmp";
+	{
+		std::ofstream f(tmp);
+		f << "nanorc-cache 2\n";
+		f << "specifiers" << specifiers << "\n";
+		f << "owned";
+		for (auto &kw : owned) {
+			f << " " << kw;
+		}
+		f << "\n";
+		for (auto &e : entries) {
+			f << "file " << e.second.size << " " << e.second.mtime << " " << std::hex
+				<< e.second.hash << std::dec << " " << e.first << "\n";
+			for (auto &kw : e.second.keywords) {
+				f << "kw " << kw.second << " " << kw.first << "\n";
+			}
+		}
+		if (!f) {
+			std::cout << "Unable to write extraction cache "+yellow << tmp << res+white << std::endl;
+			std::remove(tmp.c_str());
+			return false;
+		}
+	}
+	return std::rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+bool RCCache::fetch(const std::string &file, std::vector<LexContext> &found) {
+//--------------------------------------------------------------------
+// Appends the cached keywords of {file} to {found} if the file is 
+// unchanged since they were extracted. The size and modification 
+// time are checked first, the content hash only when those differ.
+// Safe to call from several threads, the entries and the hit and miss
+// counts are only touched inside the rccache critical section.
+//--------------------------------------------------------------------
+	if (path.empty()) return false;
+	struct stat st;
+	if (!enabled || stat(file.c_str(), &st) != 0) {
+		#pragma omp critical(rccache)
+		misses++;
+		return false;
+	}
+	std::string k = key(file);
+	int64_t mtime = int64_t(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+	bool cached = false;
+	Entry entry;
+	#pragma omp critical(rccache)
+	{
+		auto it = entries.find(k);
+		if (it != entries.end()) {
+			entry = it->second;
+			cached = true;
+		}
+	}
+	bool hit = cached && entry.size == uint64_t(st.st_size) && entry.mtime == mtime;
+	if (cached && !hit && entry.size == uint64_t(st.st_size)) {
+		MappedFile src(file);
+		hit = src.good() && hash(src.data(), src.size()) == entry.hash;
+	}
+	#pragma omp critical(rccache)
+	{
+		if (hit) {
+			Entry &e = entries[k];
+			e.mtime = mtime;
+			e.seen = true;
+			hits++;
+		}
+		else {
+			misses++;
+		}
+	}
+	if (!hit) return false;
+
+	int id = Lexer::intern(file);
+	for (auto &kw : entry.keywords) {
+		found.push_back(LexContext(kw.first, lex_type::Keyword, "", id, kw.second));
+	}
+	return true;
+}
+
+void RCCache::store(const std::string &file, const MappedFile &src, const std::vector<LexContext> &found,
+					size_t from) {
+//--------------------------------------------------------------------
+// Records found[from:] as the keywords of {file}, lexed from {src}.
+// The size, modification time and hash are those of the bytes which
+// were lexed, so the file is not read a second time.
+//--------------------------------------------------------------------
+	if (path.empty() || !src.good()) return;
+	Entry entry;
+	entry.size = src.size();
+	entry.mtime = src.mtime();
+	entry.hash = hash(src.data(), src.size());
+	entry.seen = true;
+	for (size_t ii = from; ii < found.size(); ii ++) {
+		entry.keywords.push_back(std::make_pair(found[ii].lex, found[ii].line));
+	}
+	std::string k = key(file);
+	#pragma omp critical(rccache)
+	entries[k] = std::move(entry);
+}
+
+int RCCache::withdraw(KeywordSet &keywords) {
+//--------------------------------------------------------------------
+// Forgets files which no longer exist, then removes from {keywords}
+// those added by earlier extractions which no cached file produces 
+// anymore. Files that simply were not part of this run keep their 
+// keywords. The withdrawn keywords stay owned until own() is called
+// once they have been written, so a declined write withdraws them
+// again next time.
+//--------------------------------------------------------------------
+	if (path.empty()) return 0;
+	std::unordered_set<std::string> produced;
+	auto e = entries.begin();
+	while (e != entries.end()) {
+		if (!e->second.seen && !std::filesystem::exists(e->first)) {
+			e = entries.erase(e);
+			continue;
+		}
+		for (auto &kw : e->second.keywords) {
+			produced.insert(kw.first);
+		}
+		e++;
+	}
+	for (auto &kw : owned) {
+		if (produced.count(kw) == 0 && keywords.erase(kw)) withdrawn++;
+	}
+	return withdrawn;
+}
+
+void RCCache::own(const KeywordSet &keywords) {
+//--------------------------------------------------------------------
+// Records {keywords}, as just written to the rc file, as the owned
+// set: keywords no longer in it are dropped and extracted ones added.
+//--------------------------------------------------------------------
+	auto o = owned.begin();
+	while (o != owned.end()) {
+		if (!keywords.contains(*o)) o = owned.erase(o);
+		else o++;
+	}
+	for (auto &kw : keywords) {
+		if (kw.origin == Parsed) owned.insert(kw.word);
+	}
+}
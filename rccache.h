@@ -0,0 +1,59 @@
+/* rccache.h
+ *
+ * William Miller
+ * Oct 17, 2026
+ *
+ * Persistent cache of the keywords extracted from each code file, 
+ * keyed by the file's size, modification time and content hash, so
+ * that unchanged files are not lexed again on later runs. The cache
+ * also remembers which keywords were added to the rc file by 
+ * extraction so they can be withdrawn once no cached file produces
+ * them anymore.
+ *
+ */
+
+#ifndef RCCACHE_H
+#define RCCACHE_H
+
+#include "nanorc.h"
+
+class RCCache {
+public:
+	struct Entry {
+		uint64_t size = 0;
+		int64_t mtime = 0;
+		uint64_t hash = 0;
+		std::vector<std::pair<std::string, int> > keywords;			// Keyword and line
+		bool seen = false;
+	};
+
+	RCCache() {}
+	RCCache(std::string path, std::vector<std::string> specifiers);
+
+	static std::string locate(std::string rcfile, std::string mode);
+	static uint64_t hash(const char* data, size_t size);
+
+	bool load();
+	bool save();
+
+	bool fetch(const std::string &file, std::vector<LexContext> &found);
+	void store(const std::string &file, const MappedFile &src, const std::vector<LexContext> &found, 
+			   size_t from = 0);
+	int withdraw(KeywordSet &keywords);
+	void own(const KeywordSet &keywords);
+
+	bool enabled = true;
+	int hits = 0;
+	int misses = 0;
+	int withdrawn = 0;
+
+private:
+	static std::string key(const std::string &file);
+
+	std::string path;
+	std::string specifiers;
+	std::unordered_map<std::string, Entry> entries;
+	std::set<std::string> owned;
+};
+
+#endif // RCCACHE_H
@@ -0,0 +1,299 @@
+/* rcdocument.c++
+ *
+ * William Miller
+ * Oct 17, 2026
+ *
+ * A section starts at one of the recognised '## ...' header lines.
+ * The ignore section continues over the '#' lines following it, a
+ * keyword section over the comment and 'color' lines following it,
+ * so that both end at the first blank line or other directive, which
+ * starts a verbatim section again.
+ *
+ */
+
+#include "rcdocument.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+bool RcDocument::load(std::string path) {
+//--------------------------------------------------------------------
+// Parses {path} into sections. A missing file gives an empty
+// document which is created by the first save().
+//--------------------------------------------------------------------
+	this->path = path;
+	sections.clear();
+	eol = true;
+	MappedFile src(path);
+	if (!src.good()) return false;
+
+	const char* p = src.data();
+	const char* end = p + src.size();
+	while (p < end) {
+		const char* nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+		std::string line(p, nl ? nl - p : end - p);
+		p = nl ? nl + 1 : end;
+		if (!nl) eol = false;
+
+		std::string t = trim(line);
+		rc_section type = classify(t);
+		if (type != Verbatim) {
+			sections.push_back({type, {line}, false});
+			continue;
+		}
+		bool member = false;
+		if (!sections.empty() && sections.back().type == Ignore) {
+			member = !t.empty() && t[0] == '#';
+		}
+		else if (!sections.empty() && sections.back().type != Verbatim) {
+			member = (!t.empty() && t[0] == '#') || is_rule(t, "");
+		}
+		if (member || (!sections.empty() && sections.back().type == Verbatim)) {
+			sections.back().lines.push_back(line);
+		}
+		else {
+			sections.push_back({Verbatim, {line}, false});
+		}
+	}
+	return true;
+}
+
+bool RcDocument::save() {
+//--------------------------------------------------------------------
+// Writes the document to {path} if any section changed. Unchanged
+// sections are written exactly as they were read. The text goes to
+// a temporary file beside the rc file which is synced and renamed
+// over it, so the rc file is always either the old or new version.
+// A symlinked rc file is replaced at its target.
+//--------------------------------------------------------------------
+	if (!dirty()) return true;
+	std::string target = path;
+	std::error_code ec;
+	if (std::filesystem::is_symlink(path, ec)) {
+		auto resolved = std::filesystem::canonical(path, ec);
+		if (!ec) target = resolved.string();
+	}
+
+	std::string text;
+	for (auto &s : sections) {
+		for (auto &line : s.lines) {
+			text += line;
+			text += '\n';
+		}
+	}
+	if (!eol && !text.empty()) text.pop_back();
+
+	struct stat st;
+	mode_t mode = 0644;
+	if (stat(target.c_str(), &st) == 0) mode = st.st_mode & 07777;
+	std::string tmp = target+".tmp";
+	int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, mode);
+	bool ok = fd >= 0;
+	size_t done = 0;
+	while (ok && done < text.size()) {
+		ssize_t n = ::write(fd, text.data() + done, text.size() - done);
+		if (n < 0 && errno == EINTR) continue;
+		ok = n > 0;
+		if (ok) done += n;
+	}
+	ok = ok && fsync(fd) == 0;
+	if (fd >= 0) ok = ::close(fd) == 0 && ok;
+	ok = ok && std::rename(tmp.c_str(), target.c_str()) == 0;
+	if (!ok) {
+		int err = errno;
+		std::cout << "Unable to write "+yellow << target << res+white+": " << std::strerror(err) << std::endl;
+		std::remove(tmp.c_str());
+		return false;
+	}
+
+	std::string dir = std::filesystem::path(target).parent_path().string();
+	int dfd = ::open(dir.empty() ? "." : dir.c_str(), O_RDONLY | O_DIRECTORY);
+	if (dfd >= 0) {
+		fsync(dfd);
+		::close(dfd);
+	}
+	for (auto &s : sections) {
+		s.dirty = false;
+	}
+	return true;
+}
+
+rc_section RcDocument::section(std::string mode) {
+	if (mode == "lib") return Library;
+	if (mode == "builtin") return Builtin;
+	return Custom;
+}
+
+std::string RcDocument::header(rc_section type) {
+	switch (type) {
+		case Ignore:  return "## ignore";
+		case Custom:  return "## custom keywords";
+		case Library: return "## library keywords";
+		case Builtin: return "## builtin keywords";
+		default:      return "";
+	}
+}
+
+std::vector<std::string> RcDocument::ignored() const {
+//--------------------------------------------------------------------
+// The keywords of the ignore section, one per '# keyword' line.
+//--------------------------------------------------------------------
+	std::vector<std::string> words;
+	const Section* s = find(Ignore);
+	if (!s) return words;
+	for (size_t ii = 1; ii < s->lines.size(); ii ++) {
+		std::string t = trim(s->lines[ii]);
+		size_t start = t.find_first_not_of("# \t");
+		if (start != std::string::npos) {
+			words.push_back(t.substr(start));
+		}
+	}
+	return words;
+}
+
+void RcDocument::set_ignored(const KeywordSet &words) {
+//--------------------------------------------------------------------
+// Replaces the ignore section with {words}, adding the section ahead
+// of the keyword sections if there is none yet.
+//--------------------------------------------------------------------
+	Section* s = find(Ignore);
+	if (!s) s = &create(Ignore);
+	std::vector<std::string> lines = {s->lines[0]};
+	for (auto &w : words) {
+		lines.push_back("# "+w.word);
+	}
+	update(*s, lines);
+}
+
+std::vector<std::string> RcDocument::rules(rc_section type, std::string color) const {
+//--------------------------------------------------------------------
+// The 'color {color} "..."' lines of the {type} section, trimmed.
+//--------------------------------------------------------------------
+	std::vector<std::string> found;
+	const Section* s = find(type);
+	if (!s) return found;
+	for (size_t ii = 1; ii < s->lines.size(); ii ++) {
+		std::string t = trim(s->lines[ii]);
+		if (is_rule(t, color)) found.push_back(t);
+	}
+	return found;
+}
+
+void RcDocument::set_rules(rc_section type, std::string color, const std::vector<std::string> &rules) {
+//--------------------------------------------------------------------
+// Replaces the 'color {color}' lines of the {type} section with
+// {rules}, in place of the first of them. Comments and rules in other
+// colors are kept. The section is appended if there is none yet.
+//--------------------------------------------------------------------
+	Section* s = find(type);
+	if (!s) s = &create(type);
+	std::vector<std::string> lines = {s->lines[0]};
+	bool placed = false;
+	for (size_t ii = 1; ii < s->lines.size(); ii ++) {
+		if (!is_rule(trim(s->lines[ii]), color)) {
+			lines.push_back(s->lines[ii]);
+		}
+		else if (!placed) {
+			lines.insert(lines.end(), rules.begin(), rules.end());
+			placed = true;
+		}
+	}
+	if (!placed) lines.insert(lines.end(), rules.begin(), rules.end());
+	update(*s, lines);
+}
+
+bool RcDocument::dirty() const {
+	for (auto &s : sections) {
+		if (s.dirty) return true;
+	}
+	return false;
+}
+
+size_t RcDocument::size() const {
+//--------------------------------------------------------------------
+// Length of the document text as save() writes it.
+//--------------------------------------------------------------------
+	size_t n = 0;
+	for (auto &s : sections) {
+		for (auto &line : s.lines) {
+			n += line.size() + 1;
+		}
+	}
+	return (!eol && n) ? n - 1 : n;
+}
+
+std::string RcDocument::trim(const std::string &line) {
+	size_t start = line.find_first_not_of(" \t");
+	if (start == std::string::npos) return "";
+	size_t end = line.find_last_not_of(" \t\r");
+	return line.substr(start, end - start + 1);
+}
+
+rc_section RcDocument::classify(const std::string &trimmed) {
+	if (trimmed.size() < 2 || trimmed[0] != '#' || trimmed[1] != '#') return Verbatim;
+	std::string t = tolower(trimmed);
+	for (rc_section type : {Ignore, Custom, Library, Builtin}) {
+		if (t == header(type)) return type;
+	}
+	return Verbatim;
+}
+
+bool RcDocument::is_rule(const std::string &trimmed, const std::string &color) {
+//--------------------------------------------------------------------
+// Whether {trimmed} is a 'color' or 'icolor' rule, in {color} unless
+// {color} is empty.
+//--------------------------------------------------------------------
+	size_t quote = trimmed.find('"');
+	if (quote == std::string::npos) return false;
+	std::istringstream words(trimmed.substr(0, quote));
+	std::string cmd, name, extra;
+	words >> cmd >> name;
+	if ((cmd != "color" && cmd != "icolor") || name.empty() || (words >> extra)) return false;
+	return color.empty() || (cmd == "color" && name == color);
+}
+
+const RcDocument::Section* RcDocument::find(rc_section type) const {
+	for (auto &s : sections) {
+		if (s.type == type) return &s;
+	}
+	return nullptr;
+}
+
+RcDocument::Section* RcDocument::find(rc_section type) {
+	for (auto &s : sections) {
+		if (s.type == type) return &s;
+	}
+	return nullptr;
+}
+
+RcDocument::Section& RcDocument::create(rc_section type) {
+//--------------------------------------------------------------------
+// Adds an empty {type} section separated by a blank line. The ignore
+// section goes ahead of the keyword sections, others at the end.
+//--------------------------------------------------------------------
+	Section s = {type, {header(type)}, true};
+	if (type == Ignore) {
+		for (size_t ii = 0; ii < sections.size(); ii ++) {
+			if (sections[ii].type != Verbatim) {
+				sections.insert(sections.begin() + ii, {Verbatim, {""}, true});
+				sections.insert(sections.begin() + ii, s);
+				return sections[ii];
+			}
+		}
+	}
+	if (!sections.empty() && !trim(sections.back().lines.back()).empty()) {
+		sections.push_back({Verbatim, {""}, true});
+	}
+	eol = true;
+	sections.push_back(s);
+	return sections.back();
+}
+
+void RcDocument::update(Section &section, std::vector<std::string> lines) {
+	if (lines != section.lines) {
+		section.lines = std::move(lines);
+		section.dirty = true;
+	}
+}
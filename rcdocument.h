@@ -0,0 +1,69 @@
+/* rcdocument.h
+ *
+ * William Miller
+ * Oct 17, 2026
+ *
+ * An rc file parsed once into sections. The '## ignore' list and the
+ * custom, library and builtin keyword blocks can be read and replaced
+ * independently of one another, every other line is kept verbatim.
+ * Saving only regenerates the sections which changed, goes through a
+ * synced temporary file renamed over the rc file, and does nothing
+ * at all when no section changed.
+ *
+ */
+
+#ifndef RCDOCUMENT_H
+#define RCDOCUMENT_H
+
+#include "nanorc.h"
+
+enum rc_section {
+	Verbatim,										// Anything not managed by nanorc
+	Ignore,											// '## ignore', one '# keyword' per line
+	Custom,											// '## custom keywords'
+	Library,										// '## library keywords'
+	Builtin											// '## builtin keywords'
+};
+
+class RcDocument {
+public:
+	struct Section {
+		rc_section type;
+		std::vector<std::string> lines;				// Header line first, if any
+		bool dirty;
+	};
+
+	RcDocument() {}
+	RcDocument(std::string path) { load(path); }
+
+	bool load(std::string path);
+	bool save();
+
+	static rc_section section(std::string mode);
+	static std::string header(rc_section type);
+
+	std::vector<std::string> ignored() const;
+	void set_ignored(const KeywordSet &words);
+	std::vector<std::string> rules(rc_section type, std::string color) const;
+	void set_rules(rc_section type, std::string color, const std::vector<std::string> &rules);
+
+	bool dirty() const;
+	size_t size() const;
+	const std::string& filename() const { return path; }
+
+private:
+	static std::string trim(const std::string &line);
+	static rc_section classify(const std::string &trimmed);
+	static bool is_rule(const std::string &trimmed, const std::string &color);
+
+	const Section* find(rc_section type) const;
+	Section* find(rc_section type);
+	Section& create(rc_section type);
+	void update(Section &section, std::vector<std::string> lines);
+
+	std::string path;
+	std::vector<Section> sections;
+	bool eol = true;								// Whether the last line ends in a newline
+};
+
+#endif // RCDOCUMENT_H
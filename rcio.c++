@@ -10,8 +10,7 @@
 
 #include "rcio.h"
 
-void print_table(std::vector<std::string> strings, std::vector<bool> changed, 
-		std::string mode, int tabsize) {
+void print_table(const KeywordSet &strings, std::string mode, int tabsize) {
 	int nelements = strings.size();
 	if (nelements == 0) {
 		std::cout << "Table is empty" << std::endl;
@@ -19,8 +18,8 @@ void print_table(std::vector<std::string> strings, std::vector<bool> changed,
 	}
 	int max_length = 0;
 	for (int ii = 0; ii < nelements; ii ++) {
-		if (strings[ii].length() > max_length) {
-			max_length = strings[ii].length();
+		if (strings[ii].word.length() > max_length) {
+			max_length = strings[ii].word.length();
 		}
 	}
 	// Get the screen width and height to print table cleanly
@@ -54,13 +53,8 @@ void print_table(std::vector<std::string> strings, std::vector<bool> changed,
 			if (mode == "user") std::cout << bright+cyan;
 			else if (mode == "lib") std::cout << bright+yellow;
 			else if (mode == "builtin") std::cout << green;
-			if (keywords.begin(), std::find(keywords.begin(), 
-				 keywords.end(), strings[ii+jj*nrows]) != keywords.end()) {
-				int pos = std::distance(keywords.begin(), std::find(
-				keywords.begin(), keywords.end(), strings[ii+jj*nrows]));
-				if (pos < changed.size() && changed[pos]) std::cout << bright+green;
-			}
-			std::cout << std::left << std::setw(max_length) << strings[ii+jj*nrows];
+			if (strings[ii+jj*nrows].changed) std::cout << bright+green;
+			std::cout << std::left << std::setw(max_length) << strings[ii+jj*nrows].word;
 			std::cout << " " << white+res;
 			if (jj % (ncolumns+1) == ncolumns) {
 				std::cout << std::endl;
@@ -86,3 +80,68 @@ std::string tolower(std::string str) {
 	return ret;
 }
 
+KeywordSet rcParse(const RcDocument &rc, std::string mode) {
+//--------------------------------------------------------------------
+// Returns the keywords of the {mode} section of {rc} highlighted in
+// the keyword color, and reads its ignore section into {ignored}.
+//--------------------------------------------------------------------
+	KeywordSet keywords;
+	if (verbose) std::cout << "Parsing existing keywords... \n"; 
+	for (auto &i : rc.ignored()) {
+		ignored.insert(i);
+	}
+	for (auto &line : rc.rules(RcDocument::section(mode), keywordColor)) {
+		for (auto &p : lineParse(line, keywords)) {
+			keywords.insert(p);
+		}
+	}
+	return keywords;
+}
+
+std::vector<std::string> lineParse(std::string line, const KeywordSet &keywords) {
+//--------------------------------------------------------------------
+// Returns the keywords matched by the outermost group of rule {line}
+// which are not already in {keywords}.
+//--------------------------------------------------------------------
+	std::vector<std::string> parsed;
+	size_t start = line.find_first_of("(");
+	size_t end = line.find_last_of(")");
+	if (start != std::string::npos && end != std::string::npos && end > start) {
+		for (auto &token : RegexTrie::expand(line.substr(start+1, end-start-1))) {
+			if (!keywords.contains(token) && !contains(parsed, token)) {
+				if (verbose) {
+					std::cout << "Keyword "+bright+magenta+token+res+white+" added.\n";
+				}
+				parsed.push_back(token);
+			}
+			else {
+				if (verbose) {
+					std::cout << "Duplicate keyword "+bright+magenta+token+res+white
+						+" found.\n";
+				}
+			}
+		}
+	}
+	return parsed;
+}
+
+bool write(RcDocument &rc, std::string mode) {
+//--------------------------------------------------------------------
+// Replaces the keyword rules of the {mode} section of {rc} with the
+// current keyword set and saves it.
+//--------------------------------------------------------------------
+	std::vector<std::string> words;
+	for (auto &k : keywords) {
+		words.push_back(k.word);
+	}
+	if (mode == "builtin") words.push_back("const");
+	auto t0 = RunStats::clock::now();
+	rc.set_rules(RcDocument::section(mode), keywordColor, RegexTrie::rules(words, keywordColor, ruleLength));
+	bool saved = rc.save();
+	runStats.add(RcWrite, RunStats::since(t0), saved, rc.size(), 0, words.size());
+	return saved;
+}
+
+bool contains(const std::vector<std::string> &v, const std::string &item) {
+	return (std::find(v.begin(), v.end(), item) != v.end());
+}
@@ -13,10 +13,15 @@
 
 #include "nanorc.h"
 
-void print_table(std::vector<std::string> strings, 
-					  std::vector<bool> changed = std::vector<bool>(), 
-					  std::string mode = "user", int tabsize=4);
+void print_table(const KeywordSet &strings, std::string mode = "user", int tabsize=4);
 void tab(int tabsize=8);
 std::string tolower(std::string str);
 
+class RcDocument;
+KeywordSet rcParse(const RcDocument &rc, std::string mode);
+std::vector<std::string> lineParse(std::string line, const KeywordSet &keywords);
+bool write(RcDocument &rc, std::string mode);
+
+bool contains(const std::vector<std::string> &v, const std::string &item);		// Return if {v} contains {item}
+
 #endif // RCIO_H
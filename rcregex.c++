@@ -0,0 +1,217 @@
+/* rcregex.c++
+ *
+ * William Miller
+ * Oct 17, 2026
+ *
+ * The regexes are POSIX extended, as compiled by nano. Bracket
+ * expressions only ever hold letters, digits and '_', as backslashes
+ * and ranges inside them are locale and implementation dependent.
+ *
+ */
+
+#include "rcregex.h"
+
+static bool wordchar(char c) {
+	return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+RegexTrie::RegexTrie() : nodes(1) {}
+
+RegexTrie::RegexTrie(const std::vector<std::string> &words) : nodes(1) {
+	for (auto &w : words) {
+		insert(w);
+	}
+}
+
+void RegexTrie::insert(const std::string &word) {
+	if (word.empty()) return;
+	int node = 0;
+	for (char c : word) {
+		auto it = nodes[node].next.find(c);
+		if (it == nodes[node].next.end()) {
+			nodes.push_back(Node());
+			it = nodes[node].next.emplace(c, nodes.size() - 1).first;
+		}
+		node = it->second;
+	}
+	nodes[node].end = true;
+}
+
+std::string RegexTrie::regex() const {
+	return regex(0);
+}
+
+std::string RegexTrie::regex(int node) const {
+//--------------------------------------------------------------------
+// The alternation matching every suffix below {node}. Children which
+// end a word with a single word character are merged into a bracket
+// expression, and a node which both ends a word and continues makes
+// its continuation optional. The root is not parenthesised.
+//--------------------------------------------------------------------
+	const Node &n = nodes[node];
+	std::vector<std::string> alternatives;
+	std::string singles;
+	for (auto &kv : n.next) {
+		if (nodes[kv.second].next.empty() && wordchar(kv.first)) {
+			singles += kv.first;
+		}
+		else {
+			alternatives.push_back(escape(std::string(1, kv.first))+regex(kv.second));
+		}
+	}
+	bool atom = false;
+	if (singles.size() == 1) {
+		alternatives.insert(alternatives.begin(), singles);
+		atom = true;
+	}
+	else if (singles.size() > 1) {
+		alternatives.insert(alternatives.begin(), "["+singles+"]");
+		atom = true;
+	}
+	if (alternatives.empty()) return "";
+
+	std::string out;
+	if (alternatives.size() == 1) {
+		out = alternatives[0];
+		atom = atom || out.size() == 1 || (out.size() == 2 && out[0] == '\\');
+	}
+	else {
+		for (size_t ii = 0; ii < alternatives.size(); ii ++) {
+			if (ii) out += "|";
+			out += alternatives[ii];
+		}
+		if (node == 0) return out;
+		out = "("+out+")";
+		atom = true;
+	}
+	if (n.end) {
+		out = atom ? out+"?" : "("+out+")?";
+	}
+	return out;
+}
+
+std::string RegexTrie::escape(const std::string &word) {
+	std::string out;
+	for (char c : word) {
+		if (std::strchr(".[]()|?*+{}^$\\", c)) out += '\\';
+		out += c;
+	}
+	return out;
+}
+
+static std::vector<std::string> alternation(const std::string &re, size_t &pos);
+
+static std::vector<std::string> sequence(const std::string &re, size_t &pos) {
+	std::vector<std::string> words = {""};
+	while (pos < re.size() && re[pos] != '|' && re[pos] != ')') {
+		std::vector<std::string> atom;
+		char c = re[pos++];
+		if (c == '(') {
+			atom = alternation(re, pos);
+			if (pos < re.size()) pos++;
+		}
+		else if (c == '[') {
+			size_t close = re.find(']', pos + 1);
+			if (close == std::string::npos) close = re.size();
+			for (size_t ii = pos; ii < close; ii ++) {
+				if (ii + 2 < close && re[ii + 1] == '-') {
+					for (char r = re[ii]; r <= re[ii + 2] && r >= re[ii]; r ++) {
+						atom.push_back(std::string(1, r));
+					}
+					ii += 2;
+				}
+				else {
+					atom.push_back(std::string(1, re[ii]));
+				}
+			}
+			pos = std::min(close + 1, re.size());
+		}
+		else if (c == '\\' && pos < re.size()) {
+			atom = {std::string(1, re[pos++])};
+		}
+		else {
+			atom = {std::string(1, c)};
+		}
+		if (pos < re.size() && re[pos] == '?') {
+			atom.push_back("");
+			pos++;
+		}
+		std::vector<std::string> product;
+		for (auto &w : words) {
+			for (auto &a : atom) {
+				product.push_back(w+a);
+			}
+		}
+		words.swap(product);
+	}
+	return words;
+}
+
+static std::vector<std::string> alternation(const std::string &re, size_t &pos) {
+	std::vector<std::string> words = sequence(re, pos);
+	while (pos < re.size() && re[pos] == '|') {
+		pos++;
+		std::vector<std::string> more = sequence(re, pos);
+		words.insert(words.end(), more.begin(), more.end());
+	}
+	return words;
+}
+
+std::vector<std::string> RegexTrie::expand(const std::string &regex) {
+//--------------------------------------------------------------------
+// Every word matched by {regex}, an alternation made of literal and
+// escaped characters, groups, bracket expressions and '?', as the
+// emitted rules and the plain 'a|b|c' lists of older rc files are.
+//--------------------------------------------------------------------
+	size_t pos = 0;
+	std::vector<std::string> words = alternation(regex, pos);
+	words.erase(std::remove(words.begin(), words.end(), ""), words.end());
+	return words;
+}
+
+std::vector<std::string> RegexTrie::rules(std::vector<std::string> words, std::string color, size_t length) {
+//--------------------------------------------------------------------
+// Highlighting rules for {words} in {color}, each a single word
+// bounded alternation of no more than {length} characters unless it
+// holds only one keyword. Runs of sorted keywords share the most
+// prefixes, so each rule takes the longest run which still fits.
+//--------------------------------------------------------------------
+	std::sort(words.begin(), words.end());
+	words.erase(std::unique(words.begin(), words.end()), words.end());
+	words.erase(std::remove(words.begin(), words.end(), ""), words.end());
+
+	std::string prefix = "\tcolor "+color+" \"\\<(";
+	std::string suffix = ")\\>\"";
+	size_t budget = length > prefix.size() + suffix.size() ? length - prefix.size() - suffix.size() : 0;
+	std::vector<std::string> lines;
+	size_t start = 0;
+	while (start < words.size()) {
+		auto fits = [&](size_t n) {
+			RegexTrie trie;
+			for (size_t ii = start; ii < start + n; ii ++) {
+				trie.insert(words[ii]);
+			}
+			return trie.regex().size() <= budget;
+		};
+		size_t remaining = words.size() - start;
+		size_t good = 1;
+		size_t bad = remaining + 1;
+		for (size_t n = 2; n < bad; n = std::min(n * 2, remaining)) {
+			if (fits(n)) good = n;
+			else bad = n;
+			if (n == remaining) break;
+		}
+		while (bad - good > 1) {
+			size_t mid = (good + bad) / 2;
+			if (fits(mid)) good = mid;
+			else bad = mid;
+		}
+		RegexTrie trie;
+		for (size_t ii = start; ii < start + good; ii ++) {
+			trie.insert(words[ii]);
+		}
+		lines.push_back(prefix+trie.regex()+suffix);
+		start += good;
+	}
+	return lines;
+}
@@ -0,0 +1,45 @@
+/* rcregex.h
+ *
+ * William Miller
+ * Oct 17, 2026
+ *
+ * Emission of keyword highlighting rules as compact regexes. The
+ * keywords are built into a trie which is written out as a prefix
+ * factored alternation, e.g. {Gadget, Getter, Get} as G(adget|et(ter)?),
+ * with bracket expressions for sets of single characters, and the
+ * keywords are packed into as few word-bounded rules as fit in the
+ * given rule length. expand() reads such an alternation back into
+ * the keywords it matches.
+ *
+ */
+
+#ifndef RCREGEX_H
+#define RCREGEX_H
+
+#include "nanorc.h"
+
+class RegexTrie {
+public:
+	RegexTrie();
+	RegexTrie(const std::vector<std::string> &words);
+
+	void insert(const std::string &word);
+	std::string regex() const;
+
+	static std::string escape(const std::string &word);
+	static std::vector<std::string> expand(const std::string &regex);
+	static std::vector<std::string> rules(std::vector<std::string> words, std::string color,
+										  size_t length = 1024);
+
+private:
+	struct Node {
+		std::map<char, int> next;
+		bool end = false;
+	};
+
+	std::string regex(int node) const;
+
+	std::vector<Node> nodes;
+};
+
+#endif // RCREGEX_H
@@ -0,0 +1,86 @@
+/* stats.c++
+ *
+ * William Miller
+ * Oct 17, 2026
+ *
+ * The JSON written by json() is
+ *
+ *     {"wall_seconds": ..., "jobs": ...,
+ *      "phases": {"walk": {"seconds": ..., "files": ..., "bytes": ...,
+ *                          "lexemes": ..., "keywords": ...}, ...},
+ *      "counters": {"<name>": ..., ...}}
+ *
+ */
+
+#include "stats.h"
+
+RunStats runStats;
+
+void RunStats::add(run_phase phase, double seconds, uint64_t files, uint64_t bytes, 
+				   uint64_t lexemes, uint64_t keywords) {
+//--------------------------------------------------------------------
+// Safe to call from several threads.
+//--------------------------------------------------------------------
+	#pragma omp critical(stats)
+	{
+		Phase &p = phases[phase];
+		p.seconds += seconds;
+		p.files += files;
+		p.bytes += bytes;
+		p.lexemes += lexemes;
+		p.keywords += keywords;
+	}
+}
+
+void RunStats::counter(std::string name, uint64_t value) {
+	for (auto &c : counters) {
+		if (c.first == name) {
+			c.second = value;
+			return;
+		}
+	}
+	counters.push_back(std::make_pair(name, value));
+}
+
+double RunStats::since(clock::time_point t0) {
+	return std::chrono::duration<double>(clock::now() - t0).count();
+}
+
+const char* RunStats::name(run_phase phase) {
+	static const char* names[NPhases] = {"walk", "lex", "extract", "merge", "rc_parse", "rc_write"};
+	return names[phase];
+}
+
+void RunStats::print(std::ostream &out) const {
+	out << std::left << std::setw(10) << "Phase" << std::right << std::setw(12) << "Time (s)" 
+		<< std::setw(8) << "Files" << std::setw(12) << "Bytes" << std::setw(12) << "Lexemes"
+		<< std::setw(10) << "Keywords" << std::setw(10) << "MB/s" << "\n";
+	for (int ii = 0; ii < NPhases; ii ++) {
+		const Phase &p = phases[ii];
+		out << std::left << std::setw(10) << name(static_cast<run_phase>(ii)) << std::right 
+			<< std::fixed << std::setprecision(4) << std::setw(12) << p.seconds 
+			<< std::setw(8) << p.files << std::setw(12) << p.bytes << std::setw(12) << p.lexemes 
+			<< std::setw(10) << p.keywords << std::setprecision(1) << std::setw(10);
+		if (p.bytes && p.seconds > 0) out << p.bytes / 1e6 / p.seconds;
+		else out << "-";
+		out << "\n";
+	}
+	out << "Wall time " << std::setprecision(4) << wall << " s with " << jobs << " job" 
+		<< (jobs == 1 ? "" : "s") << "." << std::endl;
+}
+
+void RunStats::json(std::ostream &out) const {
+	out << std::setprecision(6) << std::fixed;
+	out << "{\"wall_seconds\": " << wall << ", \"jobs\": " << jobs << ",\n \"phases\": {";
+	for (int ii = 0; ii < NPhases; ii ++) {
+		const Phase &p = phases[ii];
+		out << (ii ? ",\n  " : "\n  ") << "\"" << name(static_cast<run_phase>(ii)) << "\": {"
+			<< "\"seconds\": " << p.seconds << ", \"files\": " << p.files << ", \"bytes\": " << p.bytes 
+			<< ", \"lexemes\": " << p.lexemes << ", \"keywords\": " << p.keywords << "}";
+	}
+	out << "},\n \"counters\": {";
+	for (size_t ii = 0; ii < counters.size(); ii ++) {
+		out << (ii ? ", " : "") << "\"" << counters[ii].first << "\": " << counters[ii].second;
+	}
+	out << "}}" << std::endl;
+}
@@ -0,0 +1,63 @@
+/* stats.h
+ *
+ * William Miller
+ * Oct 17, 2026
+ *
+ * Per-phase instrumentation for --stats. Each phase of a run (walk,
+ * lex, extract, merge, rc parse and rc write) accumulates the time
+ * spent in it along with the files, bytes, lexemes and keywords it
+ * handled. With several jobs the times of the parallel phases are
+ * summed over threads and may exceed the wall time of the run. The
+ * totals are printed as a table or written as JSON.
+ *
+ */
+
+#ifndef STATS_H
+#define STATS_H
+
+#include "nanorc.h"
+
+enum run_phase {
+	Walk,											// Listing directories and filtering entries
+	Lex,											// Lexing, with streaming keyword extraction
+	Extract,										// Collecting keywords, from the cache or lexer
+	Merge,											// Merging keywords into the keyword set
+	RcParse,										// Loading and parsing the rc file
+	RcWrite,										// Emitting rules and saving the rc file
+	NPhases
+};
+
+class RunStats {
+public:
+	struct Phase {
+		double seconds = 0;
+		uint64_t files = 0;
+		uint64_t bytes = 0;
+		uint64_t lexemes = 0;
+		uint64_t keywords = 0;
+	};
+
+	typedef std::chrono::steady_clock clock;
+
+	void add(run_phase phase, double seconds, uint64_t files = 0, uint64_t bytes = 0, 
+			 uint64_t lexemes = 0, uint64_t keywords = 0);
+	void counter(std::string name, uint64_t value);
+	const Phase& operator[](run_phase phase) const { return phases[phase]; }
+
+	static double since(clock::time_point t0);
+	static const char* name(run_phase phase);
+
+	void print(std::ostream &out) const;
+	void json(std::ostream &out) const;
+
+	double wall = 0;
+	int jobs = 1;
+
+private:
+	Phase phases[NPhases];
+	std::vector<std::pair<std::string, uint64_t> > counters;
+};
+
+extern RunStats runStats;
+
+#endif // STATS_H
@@ -0,0 +1,99 @@
+/* rccache_test.c++
+ *
+ * William Miller
+ * Oct 17, 2026
+ *
+ * Checks that the extraction cache keeps a single entry for a file
+ * reached through different path spellings, so that keywords the file
+ * no longer declares are withdrawn, and that they are withdrawn again
+ * when the write removing them was declined. Caches of the previous
+ * format, which were not keyed on canonical paths, are discarded.
+ *
+ */
+
+#include "../nanorc.h"
+
+bool verbose = false;
+bool lexverbose = false;
+bool ctxverbose = false;
+KeywordSet keywords;
+KeywordSet ignored;
+std::string keywordColor = "brightcyan";
+int ruleLength = 1024;
+
+static int failures = 0;
+
+static void check(bool ok, std::string what) {
+	std::cout << (ok ? bright+green+"  pass  " : bright+red+"  FAIL  ")+res+white << what << std::endl;
+	if (!ok) failures++;
+}
+
+static int entries(const std::string &cache) {
+	std::ifstream f(cache);
+	std::string line;
+	int n = 0;
+	while (std::getline(f, line)) {
+		if (line.compare(0, 5, "file ") == 0) n++;
+	}
+	return n;
+}
+
+static void extract(RCCache &cache, std::string file) {
+	std::vector<LexContext> found;
+	if (!cache.fetch(file, found)) {
+		Lexer lexer({"typedef", "class", "namespace"});
+		lexer.lex(file, "c++");
+		lexer.extract(found);
+		cache.store(file, lexer.source(), found);
+	}
+	Lexer::add_kws(found, keywords);
+}
+
+int main() {
+	std::string dir = (std::filesystem::temp_directory_path() / "rccache_test.XXXXXX").string();
+	if (!mkdtemp(&dir[0])) {
+		std::cout << "Unable to create a temporary directory" << std::endl;
+		return 1;
+	}
+	std::filesystem::create_directories(dir+"/src");
+	std::string cachefile = dir+"/test.cache";
+	std::vector<std::string> specifiers = {"typedef", "class", "namespace"};
+	std::ofstream(dir+"/src/a.h") << "class Widget {\n};\n";
+
+	RCCache first(cachefile, specifiers);
+	first.load();
+	extract(first, dir+"/./src/a.h");
+	check(keywords.contains("Widget"), "Widget extracted through ./src/a.h");
+	extract(first, dir+"/src/a.h");
+	check(first.hits == 1 && first.misses == 1, "src/a.h is a cache hit after ./src/a.h");
+	first.own(keywords);
+	first.save();
+	check(entries(cachefile) == 1, "one cache entry for both spellings");
+
+	std::ofstream(dir+"/src/a.h") << "struct Widget {\n};\n";
+	RCCache second(cachefile, specifiers);
+	second.load();
+	extract(second, dir+"/src/a.h");
+	check(second.misses == 1, "changed file is a cache miss");
+	second.withdraw(keywords);
+	check(!keywords.contains("Widget"), "Widget withdrawn once no longer declared");
+
+	// The write is declined, so the rc file still holds Widget, and
+	// withdraw() alone must not have given up owning it
+	second.save();
+	keywords.insert("Widget", RcFile);
+	RCCache third(cachefile, specifiers);
+	third.load();
+	extract(third, dir+"/src/a.h");
+	third.withdraw(keywords);
+	check(!keywords.contains("Widget"), "Widget withdrawn again after a declined write");
+
+	std::ofstream(cachefile) << "nanorc-cache 1\nspecifiers class namespace typedef\nowned Widget\n"
+		"file 18 0 0 "+dir+"/./src/a.h\nkw 1 Widget\n";
+	RCCache old(cachefile, specifiers);
+	check(!old.load(), "version 1 cache discarded");
+
+	std::filesystem::remove_all(dir);
+	std::cout << (failures ? "rccache_test failed\n" : "rccache_test passed\n") << std::flush;
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,288 @@
+/* walker.c++
+ *
+ * William Miller
+ * Oct 17, 2026
+ *
+ */
+
+#include "walker.h"
+
+#include <dirent.h>
+#include <cerrno>
+#include <cstring>
+#include <sys/stat.h>
+
+std::vector<std::string> Walker::default_excludes = {".git/", ".hg/", ".svn/", "node_modules/", 
+													  "build/", "CMakeFiles/"};
+
+Walker::Walker(std::vector<std::string> extensions, std::vector<std::string> excludes) {
+	for (auto &e : extensions) {
+		uint64_t packed = pack(e.data(), e.size());
+		if (packed) this->extensions.push_back(packed);
+	}
+	this->excludes = default_excludes;
+	this->excludes.insert(this->excludes.end(), excludes.begin(), excludes.end());
+}
+
+uint64_t Walker::pack(const char* ext, size_t n) {
+//--------------------------------------------------------------------
+// Packs a lower cased extension of up to 8 characters into an 
+// integer so extensions can be compared without allocating. Returns
+// 0 for extensions which are empty or too long to be code files.
+//--------------------------------------------------------------------
+	if (n == 0 || n > 8) return 0;
+	uint64_t packed = 0;
+	for (size_t ii = 0; ii < n; ii ++) {
+		packed = (packed << 8) | static_cast<unsigned char>(std::tolower(static_cast<unsigned char>(ext[ii])));
+	}
+	return packed;
+}
+
+bool Walker::accept(const std::string &file) const {
+	size_t dot = file.find_last_of('.');
+	size_t slash = file.find_last_of('/');
+	if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) return false;
+	uint64_t packed = pack(file.data() + dot + 1, file.size() - dot - 1);
+	return packed && std::find(extensions.begin(), extensions.end(), packed) != extensions.end();
+}
+
+Walker::Rule Walker::rule(std::string pattern, std::string base) {
+//--------------------------------------------------------------------
+// Parses one .gitignore style pattern relative to {base}. Blank 
+// lines and comments give a rule with an empty pattern.
+//--------------------------------------------------------------------
+	Rule r;
+	r.base = base;
+	size_t end = pattern.find_last_not_of(" \t\r");
+	if (end == std::string::npos || pattern[0] == '#') return r;
+	pattern = pattern.substr(0, end + 1);
+	if (pattern[0] == '!') {
+		r.negate = true;
+		pattern = pattern.substr(1);
+	}
+	if (pattern.size() > 1 && pattern.back() == '/') {
+		r.dironly = true;
+		pattern.pop_back();
+	}
+	if (pattern.find('/') != std::string::npos) {
+		r.anchored = true;
+		if (pattern[0] == '/') pattern = pattern.substr(1);
+	}
+	r.pattern = pattern;
+	return r;
+}
+
+bool Walker::glob(const char* p, const char* s) {
+//--------------------------------------------------------------------
+// Matches {s} against the .gitignore style glob {p}: '*' and '?' do
+// not match '/', '**' matches anything, '**/' also matches nothing,
+// and [...] is a character class.
+//--------------------------------------------------------------------
+	while (*p) {
+		if (p[0] == '*' && p[1] == '*') {
+			p += 2;
+			if (*p == '/' && glob(p + 1, s)) return true;
+			for (; *s; s ++) {
+				if (glob(p, s)) return true;
+			}
+			return glob(p, s);
+		}
+		if (*p == '*') {
+			p++;
+			for (;; s ++) {
+				if (glob(p, s)) return true;
+				if (!*s || *s == '/') return false;
+			}
+		}
+		if (!*s) return false;
+		if (*p == '?') {
+			if (*s == '/') return false;
+		}
+		else if (*p == '[') {
+			const char* q = p + 1;
+			bool negate = (*q == '!' || *q == '^');
+			if (negate) q++;
+			bool match = false;
+			bool first = true;
+			while (*q && (*q != ']' || first)) {
+				first = false;
+				if (q[1] == '-' && q[2] && q[2] != ']') {
+					if (*s >= q[0] && *s <= q[2]) match = true;
+					q += 3;
+				}
+				else {
+					if (*s == *q) match = true;
+					q++;
+				}
+			}
+			if (!*q) {
+				if (*s != '[') return false;				// Unterminated, literal '['
+			}
+			else {
+				if (match == negate) return false;
+				p = q;
+			}
+		}
+		else {
+			if (*p == '\\' && p[1]) p++;
+			if (*p != *s) return false;
+		}
+		p++;
+		s++;
+	}
+	return !*s;
+}
+
+bool Walker::order(const std::string &a, const std::string &b) {
+//--------------------------------------------------------------------
+// Orders paths the way a serial walk visits them, i.e. component by
+// component, which is a byte comparison with '/' lowest.
+//--------------------------------------------------------------------
+	size_t n = std::min(a.size(), b.size());
+	for (size_t ii = 0; ii < n; ii ++) {
+		if (a[ii] != b[ii]) {
+			if (a[ii] == '/') return true;
+			if (b[ii] == '/') return false;
+			return static_cast<unsigned char>(a[ii]) < static_cast<unsigned char>(b[ii]);
+		}
+	}
+	return a.size() < b.size();
+}
+
+bool Walker::ignored(const std::string &path, const std::string &name, bool isdir, 
+					 const std::vector<Rule> &rules) const {
+//--------------------------------------------------------------------
+// The last matching rule decides, as in .gitignore.
+//--------------------------------------------------------------------
+	bool ignore = false;
+	for (auto &r : rules) {
+		if (r.dironly && !isdir) continue;
+		bool match;
+		if (r.anchored) {
+			if (path.size() <= r.base.size() + 1 || path.compare(0, r.base.size(), r.base) != 0) continue;
+			match = glob(r.pattern.c_str(), path.c_str() + r.base.size() + 1);
+		}
+		else {
+			match = glob(r.pattern.c_str(), name.c_str());
+		}
+		if (match) ignore = !r.negate;
+	}
+	return ignore;
+}
+
+void Walker::walk(std::vector<std::string> paths, int jobs, std::function<void(const std::string&)> visit) {
+//--------------------------------------------------------------------
+// Calls {visit} for every code file under {paths}. With more than 
+// one job each subdirectory and each file is an OpenMP task, so 
+// {visit} is called concurrently and in no particular order; all 
+// calls have returned when walk does.
+//--------------------------------------------------------------------
+	for (auto path : paths) {
+		struct stat st;
+		if (stat(path.c_str(), &st) != 0) continue;
+		if (!S_ISDIR(st.st_mode)) {
+			if (accept(path)) {
+				nfiles++;
+				visit(path);
+			}
+			continue;
+		}
+		if (verbose) {
+			std::cout << bright+red << path << res+white;
+			std::cout << " is directory, searching...\n";
+		}
+		while (path.size() > 1 && path.back() == '/') path.pop_back();
+		std::vector<Rule> rules;
+		for (auto &e : excludes) {
+			Rule r = rule(e, path);
+			if (!r.pattern.empty()) rules.push_back(r);
+		}
+		if (jobs > 1) {
+			#pragma omp parallel num_threads(jobs)
+			#pragma omp single
+			walk_dir(path, rules, true, visit);
+		}
+		else {
+			walk_dir(path, rules, false, visit);
+		}
+	}
+}
+
+std::vector<std::string> Walker::list(std::vector<std::string> paths) {
+	std::vector<std::string> files;
+	walk(paths, 1, [&files](const std::string &file) { files.push_back(file); });
+	return files;
+}
+
+void Walker::walk_dir(std::string dir, std::vector<Rule> rules, bool parallel, 
+					  const std::function<void(const std::string&)> &visit) {
+	auto t0 = RunStats::clock::now();
+	DIR* d = opendir(dir.c_str());
+	if (!d) {
+		#pragma omp critical(output)
+		std::cout << "Error while accessing " << dir << " -- " << std::strerror(errno) << "\n";
+		return;
+	}
+	std::vector<std::pair<std::string, bool> > entries;				// Name and whether it is a directory
+	bool gitignore = false;
+	struct dirent* ent;
+	while ((ent = readdir(d)) != nullptr) {
+		std::string name(ent->d_name);
+		if (name == "." || name == "..") continue;
+		if (name == ".gitignore") gitignore = true;
+		std::string path = (dir == "/" ? dir : dir+"/")+name;
+		bool isdir = ent->d_type == DT_DIR;
+		bool isfile = ent->d_type == DT_REG;
+		if (ent->d_type == DT_UNKNOWN || ent->d_type == DT_LNK) {
+			// Symbolic links to files are followed, to directories not
+			struct stat st;
+			if (lstat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) isdir = true;
+			else if (stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode)) isfile = true;
+		}
+		if (isdir || (isfile && accept(name))) entries.push_back(std::make_pair(name, isdir));
+	}
+	closedir(d);
+
+	if (gitignore) {
+		std::ifstream f(dir+"/.gitignore");
+		std::string line;
+		while (std::getline(f, line)) {
+			Rule r = rule(line, dir);
+			if (!r.pattern.empty()) rules.push_back(r);
+		}
+	}
+
+	std::sort(entries.begin(), entries.end());
+	entries.erase(std::remove_if(entries.begin(), entries.end(), [&](const std::pair<std::string, bool> &e) {
+		return ignored((dir == "/" ? dir : dir+"/")+e.first, e.first, e.second, rules);
+	}), entries.end());
+	runStats.add(Walk, RunStats::since(t0), std::count_if(entries.begin(), entries.end(), 
+		[](const std::pair<std::string, bool> &e) { return !e.second; }));
+
+	const std::function<void(const std::string&)>* fn = &visit;
+	for (auto &e : entries) {
+		std::string path = (dir == "/" ? dir : dir+"/")+e.first;
+		if (e.second) {
+			#pragma omp atomic
+			ndirs++;
+			if (parallel) {
+				#pragma omp task firstprivate(path, rules, fn)
+				walk_dir(path, rules, true, *fn);
+			}
+			else {
+				walk_dir(path, rules, false, visit);
+			}
+		}
+		else {
+			#pragma omp atomic
+			nfiles++;
+			if (parallel) {
+				#pragma omp task firstprivate(path, fn)
+				(*fn)(path);
+			}
+			else {
+				visit(path);
+			}
+		}
+	}
+}
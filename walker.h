@@ -0,0 +1,59 @@
+/* walker.h
+ *
+ * William Miller
+ * Oct 17, 2026
+ *
+ * Directory walker for recursive keyword extraction. Skips version
+ * control and build directories, honours .gitignore files and 
+ * --exclude patterns, checks extensions against a precomputed table
+ * and hands each code file to a callback as soon as it is found. 
+ * Sibling directories are walked in parallel when more than one job
+ * is requested.
+ *
+ */
+
+#ifndef WALKER_H
+#define WALKER_H
+
+#include "nanorc.h"
+
+#include <functional>
+
+class Walker {
+public:
+	struct Rule {
+		std::string pattern;
+		std::string base;								// Directory the pattern is relative to
+		bool negate = false;
+		bool dironly = false;
+		bool anchored = false;							// Pattern contains a '/', match the relative path
+	};
+
+	Walker(std::vector<std::string> extensions, std::vector<std::string> excludes = {});
+
+	void walk(std::vector<std::string> paths, int jobs, std::function<void(const std::string&)> visit);
+	std::vector<std::string> list(std::vector<std::string> paths);
+
+	bool accept(const std::string &file) const;
+	bool ignored(const std::string &path, const std::string &name, bool isdir, 
+				 const std::vector<Rule> &rules) const;
+
+	static bool glob(const char* pattern, const char* str);
+	static bool order(const std::string &a, const std::string &b);
+	static Rule rule(std::string pattern, std::string base);
+
+	int ndirs = 0;
+	int nfiles = 0;
+
+private:
+	static std::vector<std::string> default_excludes;
+
+	std::vector<uint64_t> extensions;
+	std::vector<std::string> excludes;
+
+	void walk_dir(std::string dir, std::vector<Rule> rules, bool parallel, 
+				  const std::function<void(const std::string&)> &visit);
+	static uint64_t pack(const char* ext, size_t n);
+};
+
+#endif // WALKER_H